@@ -108,6 +108,32 @@ class AddonPreferences(bpy.types.AddonPreferences):
             "but may improve performance. \n"),
     )
 
+    publish_threshold_deg: bpy.props.FloatProperty(
+        name = "Direction Threshold (°)",
+        default = ipc.PublishThresholds().direction_deg,
+        min = 0.0,
+        max = 45.0,
+        description = ("Object locations are only sent to VST instances once the direction"
+            " from the camera changed by more than this angle (or the distance or interval"
+            " thresholds are exceeded). VST instances interpolate between updates."
+            " Set to 0 to send every change."),
+    )
+    publish_threshold_db: bpy.props.FloatProperty(
+        name = "Distance Threshold (dB)",
+        default = ipc.PublishThresholds().distance_db,
+        min = 0.0,
+        max = 24.0,
+        description = ("Object locations are also sent once the distance from the camera"
+            " changed the inverse distance law gain by more than this many decibels."),
+    )
+    publish_max_interval: bpy.props.FloatProperty(
+        name = "Max Update Interval (s)",
+        default = ipc.PublishThresholds().max_interval_s,
+        min = 0.0,
+        max = 10.0,
+        description = ("Locations are sent again after this interval, even if they didn't change."),
+    )
+
     def draw(self, context):
         if not ipc.DEPENDENCIES_INSTALLED:
             self.layout.label(text="Please install dependencies before use!", icon="ERROR")
@@ -119,6 +145,9 @@ class AddonPreferences(bpy.types.AddonPreferences):
         self.layout.separator()
         self.layout.label(text='The server needs to be restarted to apply changes.', icon="INFO")
         self.layout.prop(self, "tickrate")
+        self.layout.prop(self, "publish_threshold_deg")
+        self.layout.prop(self, "publish_threshold_db")
+        self.layout.prop(self, "publish_max_interval")
 
 
 PREFERENCE_CLASSES = (InstallDependenciesOp, UninstallDependenciesOp, AddonPreferences)
@@ -2,13 +2,19 @@ import logging
 import sys
 import struct
 from io import BytesIO
-from enum import IntEnum
+from contextlib import suppress
+from enum import IntEnum, IntFlag
 from queue import Queue
+import threading
 import time
-from typing import Tuple
+from typing import Optional, Sequence, Tuple
 import mathutils
+import numpy as np
 import bpy
-from ambilink.object_info import ObjectInfoManager, ObjectNotFoundError
+from ambilink.math import get_location_camera_space
+from ambilink.object_info import ObjectInfoManager, ObjectNotFoundError, PublishThresholds
+from ambilink.object_list import encode_object_name
+from ambilink.shared_positions import SharedPositionWriter
 
 OBJECT_ID_LENGTH_BYTES = 2
 BYTE_ORDER = sys.byteorder
@@ -30,6 +36,56 @@ class PubSubMsgType(IntEnum):
     OBJ_POSITION_UPDATED = 0x00
     OBJ_RENAMED = 0x01
     OBJ_DELETED = 0x02
+    # Locations of all objects updated in a tick, published with BROADCAST_AMBILINK_ID.
+    FRAME_SNAPSHOT = 0x03
+    # View matrix of the camera, published with BROADCAST_AMBILINK_ID when it changes.
+    CAMERA_MATRIX = 0x04
+    # Same as FRAME_SNAPSHOT, with world space locations of objects that moved.
+    WORLD_SNAPSHOT = 0x05
+
+
+# Ambilink id prefix of Pub/Sub messages meant for all subscribers.
+BROADCAST_AMBILINK_ID = 0xFFFF
+
+
+# Version of the protocol implemented by the add-on, sent in reply to HELLO.
+PROTOCOL_VERSION = 1
+
+
+class Capability(IntFlag):
+    """Optional protocol features, exchanged as a bitmask with HELLO."""
+    # 1 << 0 is reserved, it was used for the removed OBJ_LIST_DELTA command.
+    OBJ_LIST_QUERY = 1 << 1
+    ENCODED_LOCATION_DATA = 1 << 2
+    SHARED_MEMORY_POSITIONS = 1 << 3
+    # GET_ANIMATION_INFO replies end with the animation revision.
+    ANIMATION_REVISION = 1 << 4
+    FRAME_SNAPSHOT = 1 << 5
+    WORLD_SPACE_POSITIONS = 1 << 6
+    # CAMERA_SUB is supported, for listener plugins rotating the whole ambisonic mix.
+    CAMERA_SUB = 1 << 7
+
+
+SERVER_CAPABILITIES = (
+    Capability.OBJ_LIST_QUERY
+    | Capability.ENCODED_LOCATION_DATA
+    | Capability.ANIMATION_REVISION
+    | Capability.FRAME_SNAPSHOT
+    | Capability.WORLD_SPACE_POSITIONS
+    | Capability.CAMERA_SUB
+)
+
+
+class SubFlags(IntFlag):
+    """Optional flags byte appended to OBJ_SUB and OBJ_UNSUB requests."""
+    NONE = 0x00
+    # Positions are read from shared memory, no need to publish them for this subscriber.
+    SHARED_MEMORY_POSITIONS = 0x01
+    # Positions are received in FRAME_SNAPSHOT messages instead of OBJ_POSITION_UPDATED.
+    FRAME_SNAPSHOTS = 0x02
+    # Positions are received in world space, in WORLD_SNAPSHOT messages, and transformed
+    # by the VST with the view matrix from CAMERA_MATRIX messages.
+    WORLD_SPACE_POSITIONS = 0x04
 
 
 class ReqRepCommand(IntEnum):
@@ -40,6 +96,11 @@ class ReqRepCommand(IntEnum):
     INFORM_RENDER_FINISHED = 0x05
     GET_RENDERING_LOCATION_DATA = 0x06
     GET_ANIMATION_INFO = 0x07
+    # 0x08 is reserved, it was used for the removed OBJ_LIST_DELTA command.
+    OBJ_LIST_QUERY = 0x09
+    GET_RENDERING_LOCATION_DATA_ENCODED = 0x0A
+    HELLO = 0x0B
+    CAMERA_SUB = 0x0C
     PING = 0xFF
 
 
@@ -51,6 +112,15 @@ class ReqRepStatusCode(IntEnum):
     UNKNOWN_COMMAND = 0xFF
 
 
+class LocationDataEncoding(IntEnum):
+    RAW_F32 = 0x00
+    QUANTIZED_DELTA_U16 = 0x01
+
+
+def match_command(command_byte: bytes, enum_value: ReqRepCommand):
+    return command_byte == enum_value.to_bytes(1, BYTE_ORDER)
+
+
 def encode_pubsub_msg(
     ambilink_id: int, msg_type_byte: PubSubMsgType, msg=None
 ) -> bytes:
@@ -74,12 +144,11 @@ def encode_reqrep_reply(
     return status_code.to_bytes(1, BYTE_ORDER) + reply_data
 
 
-def encode_object_name(name: str) -> bytes:
-    """Encode object name as [1 byte|`obj_name_length`] [`obj_name_length` bytes|`obj_name[]`]"""
-    encoded_name = name.encode("utf8")
-    # Max Blender object name length is 63 chars, so 1 byte is enough
-    # even if all symbols take up 4 bytes in utf8 (max byte count per code point).
-    return len(encoded_name).to_bytes(1, BYTE_ORDER) + encoded_name
+def encode_object_name_list(names) -> bytes:
+    """Encode a list of object names as [4 bytes|`count`] [`count` encoded object names]"""
+    return len(names).to_bytes(4, BYTE_ORDER) + b"".join(
+        encode_object_name(name) for name in names
+    )
 
 
 def decode_object_name(request_data: BytesIO) -> str:
@@ -91,6 +160,12 @@ def decode_object_name(request_data: BytesIO) -> str:
     return request_data.read(length).decode("utf8")
 
 
+def decode_sub_flags(request_data: BytesIO) -> SubFlags:
+    """Decode the optional flags byte, older VSTs don't send it."""
+    flags_byte = request_data.read(1)
+    return SubFlags(int.from_bytes(flags_byte, BYTE_ORDER)) if flags_byte else SubFlags.NONE
+
+
 def decode_ambilink_id(request_data: BytesIO) -> int:
     """Decode ambilink id - 2 byte unsigned int"""
     return int.from_bytes(request_data.read(2), BYTE_ORDER)
@@ -101,14 +176,100 @@ def encode_location(loc: mathutils.Vector):
     return struct.pack("=fff", loc.x, loc.y, loc.z)
 
 
+def encode_frame_snapshot(
+    id_positions: Sequence[Tuple[int, mathutils.Vector]],
+    msg_type: PubSubMsgType = PubSubMsgType.FRAME_SNAPSHOT,
+) -> bytes:
+    """Encode a FRAME_SNAPSHOT (or WORLD_SNAPSHOT) message as
+    [2 bytes|`count`] [`count` * ([2 bytes|`ambilink_id`] [3 floats|`location`])]"""
+    return encode_pubsub_msg(
+        BROADCAST_AMBILINK_ID,
+        msg_type,
+        len(id_positions).to_bytes(2, BYTE_ORDER)
+        + b"".join(
+            struct.pack("=Hfff", ambilink_id, loc.x, loc.y, loc.z)
+            for ambilink_id, loc in id_positions
+        ),
+    )
+
+
+def encode_camera_matrix(view_matrix: mathutils.Matrix) -> bytes:
+    """Encode a CAMERA_MATRIX message as [16 floats|`view_matrix`] in column-major order."""
+    return encode_pubsub_msg(
+        BROADCAST_AMBILINK_ID,
+        PubSubMsgType.CAMERA_MATRIX,
+        struct.pack("=16f", *(view_matrix[row][col] for col in range(4) for row in range(4))),
+    )
+
+
+def encode_locations(locations: Sequence[mathutils.Vector]) -> bytes:
+    """Encode object locations as 3 4-byte (standard size) floats per location"""
+    return np.array(locations, dtype=np.float32).reshape(-1, 3).tobytes()
+
+
+QUANTIZATION_MAX = 0xFFFF
+
+
+def encode_locations_quantized(locations: Sequence[mathutils.Vector]) -> bytes:
+    """Encode object locations as
+    [3 floats|`offset`] [3 floats|`scale`] [varints|`deltas`],
+    where `deltas` are the differences between the 16 bit quantized
+    coordinates (`location = offset + quantized * scale`)
+    of consecutive locations, zigzag encoded and written as varints (7 bits per byte).
+    """
+    coords = np.array(locations, dtype=np.float64).reshape(-1, 3)
+    if len(coords) == 0:
+        return bytes(6 * 4)
+
+    # Quantize with the float32 values the VST decodes with.
+    offset = coords.min(axis=0).astype(np.float32)
+    scale = ((coords.max(axis=0) - offset) / QUANTIZATION_MAX).astype(np.float32)
+    safe_scale = np.where(scale > 0, scale, 1).astype(np.float64)
+    quantized = np.clip(
+        np.rint((coords - offset) / safe_scale), 0, QUANTIZATION_MAX
+    ).astype(np.int32)
+
+    deltas = np.diff(quantized, axis=0, prepend=0).ravel()
+    zigzag = ((deltas << 1) ^ (deltas >> 31)).astype(np.uint32)
+
+    # Deltas fit in 17 bits, so at most 3 varint bytes are needed.
+    has_second_byte = zigzag >= 0x80
+    has_third_byte = zigzag >= 0x4000
+    varint_bytes = np.stack(
+        (
+            (zigzag & 0x7F) | (has_second_byte << 7),
+            ((zigzag >> 7) & 0x7F) | (has_third_byte << 7),
+            zigzag >> 14,
+        ),
+        axis=1,
+    ).astype(np.uint8)
+    used_bytes = np.stack(
+        (np.ones_like(has_second_byte), has_second_byte, has_third_byte), axis=1
+    )
+
+    return offset.tobytes() + scale.tobytes() + varint_bytes[used_bytes].tobytes()
+
+
 class IPCServer:
-    """Handles communication with the VST instances."""
+    """Handles communication with the VST instances.
+
+    Requests are received by a request thread, which answers those that don't need bpy
+    right away (pings, object lists without pending changes, already evaluated rendering
+    location data),
+    and queues the rest to be answered from the main thread at the next tick.
+    """
 
     REQREP_ADDRESS = "ipc:///tmp/ambilink_reqrep"
     PUBSUB_ADDRESS = "ipc:///tmp/ambilink_pubsub"
     DEFAULT_TICKRATE_HZ = 30
-
-    def __init__(self, context) -> None:
+    # CAMERA_SUB requests subscribe to CAMERA_MATRIX messages for this long,
+    # listener plugins repeat them more often, so no unsubscribe is needed.
+    CAMERA_SUB_LEASE_S = 15
+    # Max time per tick spent evaluating rendering trajectories ahead of requests,
+    # so the UI stays responsive.
+    TRAJECTORY_EVALUATION_BUDGET_S = 0.01
+
+    def __init__(self, context, publish_thresholds: PublishThresholds = PublishThresholds()) -> None:
         self._rep_sock: Rep0 = Rep0(listen=IPCServer.REQREP_ADDRESS)
         self._pub_sock: Pub0 = Pub0(listen=IPCServer.PUBSUB_ADDRESS)
         self._msg_queue: Queue = Queue()
@@ -117,11 +278,35 @@ class IPCServer:
             rename_cb=self._queue_rename_msg, delete_cb=self._queue_delete_msg,
             context=context
         )
+        self._last_published_view_matrix = None
+        self._publish_thresholds = publish_thresholds
+        self._camera_sub_expiry = 0.0
+        self._shared_positions = SharedPositionWriter.try_create()
+        self._capabilities = SERVER_CAPABILITIES
+        if self._shared_positions is not None:
+            self._capabilities |= Capability.SHARED_MEMORY_POSITIONS
+        # (pynng.Context, request) pairs received by the request thread that need bpy.
+        self._deferred_requests: Queue = Queue()
+        self._request_thread = threading.Thread(
+            target=self._receive_requests, name="ambilink-requests", daemon=True)
+        self._request_thread.start()
 
     def close_sockets(self):
-        """Close sockets. Should be called before stopping the server."""
+        """Close sockets and stop the request thread. Should be called before stopping the server."""
         self._rep_sock.close()
         self._pub_sock.close()
+        self._request_thread.join()
+        while not self._deferred_requests.empty():
+            context, _ = self._deferred_requests.get_nowait()
+            with suppress(pynng.Closed):
+                context.close()
+
+    def stop(self):
+        """Close sockets and unregister Blender handlers. Should be called before stopping the server."""
+        self.close_sockets()
+        self._obj_info_manager.stop()
+        if self._shared_positions is not None:
+            self._shared_positions.close()
 
     def serve(self, context):
         """Scheduled via blender window manager event timers.
@@ -130,11 +315,71 @@ class IPCServer:
         self._obj_info_manager.set_context(context)
         self._reply()
         if not self._rendering:
-            pos_list = self._obj_info_manager.get_updated_object_locations()
-            for id_pos in pos_list:
-                self._queue_location_update_msg(id_pos)
+            self._queue_location_updates()
+        elif self._obj_info_manager.is_rendering_trajectory_evaluation_pending():
+            self._obj_info_manager.evaluate_rendering_trajectories(
+                IPCServer.TRAJECTORY_EVALUATION_BUDGET_S)
         self._publish()
 
+    def _queue_location_updates(self):
+        """Deliver the locations of registered objects to subscribers. The view matrix is
+        computed once per tick, world space subscribers only get the view matrix if the camera
+        moved. Published locations are only updated once they differ from the previous ones
+        by more than the publish thresholds, shared memory is always updated."""
+        view_matrix = self._obj_info_manager.get_view_matrix()
+        if view_matrix is None:
+            return
+
+        now = time.monotonic()
+        camera_location = self._obj_info_manager.get_camera_location()
+        pos_list = self._obj_info_manager.get_updated_object_locations()
+        snapshot = []
+        world_snapshot = []
+        has_world_space_subscribers = False
+        for ambilink_id, world_location, registered_obj in pos_list:
+            if registered_obj.has_world_space_subscribers():
+                has_world_space_subscribers = True
+                if registered_obj.published_world_space_location.should_publish(
+                    world_location, now, self._publish_thresholds, camera_location
+                ):
+                    world_snapshot.append((ambilink_id, world_location))
+
+            if not registered_obj.has_camera_space_subscribers():
+                continue
+            location = get_location_camera_space(world_location, view_matrix)
+            if registered_obj.has_shared_memory_subscribers():
+                self._shared_positions.write(ambilink_id, location)
+            if not (
+                registered_obj.has_frame_snapshot_subscribers()
+                or registered_obj.has_pubsub_subscribers()
+            ) or not registered_obj.published_camera_space_location.should_publish(
+                location, now, self._publish_thresholds
+            ):
+                continue
+            if registered_obj.has_frame_snapshot_subscribers():
+                snapshot.append((ambilink_id, location))
+            if registered_obj.has_pubsub_subscribers():
+                self._queue_location_update_msg((ambilink_id, location))
+
+        # Ambilink ids are 16 bit, so the counts always fit.
+        if snapshot:
+            self._msg_queue.put(encode_frame_snapshot(snapshot))
+        # Locations are sent before the matrix, so a VST that just subscribed
+        # doesn't combine a new camera with the previous object's location.
+        if world_snapshot:
+            self._msg_queue.put(
+                encode_frame_snapshot(world_snapshot, PubSubMsgType.WORLD_SNAPSHOT))
+        has_camera_subscribers = (
+            has_world_space_subscribers or time.monotonic() < self._camera_sub_expiry
+        )
+        if has_camera_subscribers and (
+            self._obj_info_manager.camera_matrix_requested
+            or view_matrix != self._last_published_view_matrix
+        ):
+            self._msg_queue.put(encode_camera_matrix(view_matrix))
+            self._last_published_view_matrix = view_matrix
+            self._obj_info_manager.camera_matrix_requested = False
+
     def _queue_rename_msg(self, ambilink_id: int, new_name: str):
         """Put a rename msg into the message queue.
 
@@ -173,95 +418,227 @@ class IPCServer:
             )
         )
 
-    def _reply(self):
-        """Reply to all incoming requests using the Rep0 socket."""
-
-        def match_command(command_byte: bytes, enum_value: ReqRepCommand):
-            return command_byte == enum_value.to_bytes(1, BYTE_ORDER)
+    def _receive_requests(self):
+        """Runs on the request thread until the Rep0 socket is closed.
+        Answers requests that don't need bpy, queues the rest for `_reply`."""
+        while True:
+            try:
+                context = self._rep_sock.new_context()
+                request = context.recv()
+            except pynng.Closed:
+                return
+
+            logging.debug("received command 0x%s", request[:1].hex())
+            try:
+                reply = self._process_request_off_main_thread(request)
+            except Exception:  # pylint: disable=broad-except
+                logging.exception("Failed to process request on the request thread")
+                reply = None
+
+            if reply is None:
+                self._deferred_requests.put((context, request))
+                continue
+            try:
+                context.send(reply)
+            except pynng.Closed:
+                return
+            finally:
+                with suppress(pynng.Closed):
+                    context.close()
+
+    def _process_request_off_main_thread(self, request: bytes) -> Optional[bytes]:
+        """Build a reply to a request without accessing bpy.
+
+        Returns:
+            Optional[bytes]: None if the request must be processed on the main thread.
+        """
+        request_data = BytesIO(request)
+        command = request_data.read(1)
+
+        if match_command(command, ReqRepCommand.PING):
+            return encode_reqrep_reply(ReqRepStatusCode.SUCCESS)
+        if match_command(command, ReqRepCommand.HELLO):
+            return self._process_hello_request(request_data)
+        if match_command(command, ReqRepCommand.OBJ_LIST):
+            encoded_list = self._obj_info_manager.get_current_encoded_object_list()
+            if encoded_list is not None:
+                return encode_reqrep_reply(ReqRepStatusCode.SUCCESS, encoded_list)
+        elif match_command(command, ReqRepCommand.OBJ_LIST_QUERY):
+            known_version = struct.unpack("=Q", request_data.read(8))[0]
+            if self._obj_info_manager.is_object_list_unchanged_since(known_version):
+                return encode_reqrep_reply(
+                    ReqRepStatusCode.SUCCESS, struct.pack("=QB", known_version, True))
+        elif match_command(command, ReqRepCommand.GET_RENDERING_LOCATION_DATA):
+            return self._process_rendering_location_data_request(
+                request_data, evaluated_only=True)
+        elif match_command(command, ReqRepCommand.GET_RENDERING_LOCATION_DATA_ENCODED):
+            return self._process_encoded_rendering_location_data_request(
+                request_data, evaluated_only=True)
+        return None
 
-        try:
-            while True:
-                request_data = BytesIO(self._rep_sock.recv(block=False))
-                command = request_data.read(1)
-
-                logging.debug("received command %s", ReqRepCommand(
-                    int.from_bytes(command, byteorder=BYTE_ORDER, signed=False)))
-
-                if match_command(command, ReqRepCommand.OBJ_LIST):
-                    self._rep_sock.send(self._process_object_list_request())
-                elif match_command(command, ReqRepCommand.OBJ_SUB):
-                    self._rep_sock.send(
-                        self._process_object_sub_request(request_data))
-                elif match_command(command, ReqRepCommand.OBJ_UNSUB):
-                    self._rep_sock.send(
-                        self._process_object_unsub_request(request_data)
-                    )
-                elif match_command(command, ReqRepCommand.GET_ANIMATION_INFO):
-                    self._rep_sock.send(self._process_animation_info_request())
-                elif match_command(command, ReqRepCommand.PREPARE_TO_RENDER):
-                    self._rep_sock.send(
-                        self._process_prepare_to_render_request())
-                elif match_command(command, ReqRepCommand.INFORM_RENDER_FINISHED):
-                    self._rep_sock.send(
-                        self._process_inform_render_finished_request())
-                elif match_command(command, ReqRepCommand.GET_RENDERING_LOCATION_DATA):
-                    self._rep_sock.send(
-                        self._process_rendering_location_data_request(
-                            request_data)
-                    )
-                elif match_command(command, ReqRepCommand.PING):
-                    self._rep_sock.send(
-                        encode_reqrep_reply(ReqRepStatusCode.SUCCESS))
-                else:
-                    self._rep_sock.send(
-                        encode_reqrep_reply(ReqRepStatusCode.UNKNOWN_COMMAND)
-                    )
-        except pynng.TryAgain:
-            pass
+    def _reply(self):
+        """Reply to the requests queued by the request thread."""
+        while not self._deferred_requests.empty():
+            context, request = self._deferred_requests.get_nowait()
+            try:
+                context.send(self._process_request(request))
+            finally:
+                with suppress(pynng.Closed):
+                    context.close()
+
+    def _process_request(self, request: bytes) -> bytes:
+        """Build a reply to a request, must be called from the main thread."""
+        request_data = BytesIO(request)
+        command = request_data.read(1)
+
+        if match_command(command, ReqRepCommand.HELLO):
+            return self._process_hello_request(request_data)
+        if match_command(command, ReqRepCommand.OBJ_LIST):
+            return self._process_object_list_request()
+        if match_command(command, ReqRepCommand.OBJ_LIST_QUERY):
+            return self._process_object_list_query_request(request_data)
+        if match_command(command, ReqRepCommand.OBJ_SUB):
+            return self._process_object_sub_request(request_data)
+        if match_command(command, ReqRepCommand.OBJ_UNSUB):
+            return self._process_object_unsub_request(request_data)
+        if match_command(command, ReqRepCommand.GET_ANIMATION_INFO):
+            return self._process_animation_info_request()
+        if match_command(command, ReqRepCommand.PREPARE_TO_RENDER):
+            return self._process_prepare_to_render_request()
+        if match_command(command, ReqRepCommand.INFORM_RENDER_FINISHED):
+            return self._process_inform_render_finished_request()
+        if match_command(command, ReqRepCommand.GET_RENDERING_LOCATION_DATA):
+            return self._process_rendering_location_data_request(request_data)
+        if match_command(command, ReqRepCommand.GET_RENDERING_LOCATION_DATA_ENCODED):
+            return self._process_encoded_rendering_location_data_request(request_data)
+        if match_command(command, ReqRepCommand.CAMERA_SUB):
+            return self._process_camera_sub_request()
+        if match_command(command, ReqRepCommand.PING):
+            return encode_reqrep_reply(ReqRepStatusCode.SUCCESS)
+        return encode_reqrep_reply(ReqRepStatusCode.UNKNOWN_COMMAND)
+
+    def _process_hello_request(self, request_data: BytesIO):
+        client_version, client_capabilities = struct.unpack(
+            "=HI", request_data.read(6))
+        logging.debug(
+            "VST connected (protocol version %d, capabilities %s)",
+            client_version,
+            Capability(client_capabilities & self._capabilities),
+        )
+        return encode_reqrep_reply(
+            ReqRepStatusCode.SUCCESS,
+            struct.pack("=HI", PROTOCOL_VERSION, self._capabilities),
+        )
 
     def _process_animation_info_request(self):
+        """Reply with the frame count, fps and the animation revision, which VST instances
+        use to reuse rendering location data from previous renders."""
         frame_count, fps = self._obj_info_manager.get_animation_info()
         return encode_reqrep_reply(
-            ReqRepStatusCode.SUCCESS, struct.pack("=Qf", frame_count, fps)
+            ReqRepStatusCode.SUCCESS,
+            struct.pack("=QfQ", frame_count, fps, self._obj_info_manager.animation_revision),
         )
 
-    def _process_rendering_location_data_request(self, request_data: BytesIO):
+    def _get_rendering_locations(self, request_data: BytesIO, evaluated_only: bool = False):
+        """Decodes a location data request, returns the requested locations,
+        or None if the object isn't registered.
+        If `evaluated_only` is True, bpy isn't accessed to evaluate missing frames,
+        None also means some of the frames haven't been evaluated yet."""
         ambilink_id = decode_ambilink_id(request_data)
         start_frame = int.from_bytes(
             request_data.read(8), BYTE_ORDER, signed=False)
         end_frame = int.from_bytes(
             request_data.read(8), BYTE_ORDER, signed=False)
 
-        locs_per_object = (
-            ObjectInfoManager.get_rendering_location_data_for_registered_objects(
-                self._obj_info_manager, start_frame, end_frame
-            )
-        )
+        if evaluated_only:
+            return self._obj_info_manager.get_evaluated_rendering_location_data(
+                ambilink_id, start_frame, end_frame)
+        return self._obj_info_manager.get_rendering_location_data(
+            ambilink_id, start_frame, end_frame)
+
+    def _process_rendering_location_data_request(
+        self, request_data: BytesIO, evaluated_only: bool = False
+    ) -> Optional[bytes]:
+        """Returns None if `evaluated_only` is True and the locations aren't evaluated yet."""
+        locations = self._get_rendering_locations(request_data, evaluated_only)
+        if locations is None:
+            return None if evaluated_only else encode_reqrep_reply(ReqRepStatusCode.OBJECT_NOT_FOUND)
+
+        return encode_reqrep_reply(ReqRepStatusCode.SUCCESS, encode_locations(locations))
+
+    def _process_encoded_rendering_location_data_request(
+        self, request_data: BytesIO, evaluated_only: bool = False
+    ) -> Optional[bytes]:
+        """Returns None if `evaluated_only` is True and the locations aren't evaluated yet."""
+        locations = self._get_rendering_locations(request_data, evaluated_only)
+        if locations is None:
+            return None if evaluated_only else encode_reqrep_reply(ReqRepStatusCode.OBJECT_NOT_FOUND)
 
-        if ambilink_id not in locs_per_object:
-            return encode_reqrep_reply(ReqRepStatusCode.OBJECT_NOT_FOUND)
+        try:
+            encoding = LocationDataEncoding(
+                int.from_bytes(request_data.read(1), BYTE_ORDER))
+        except ValueError:
+            encoding = LocationDataEncoding.RAW_F32
 
-        reply_data = BytesIO()
-        for location in locs_per_object[ambilink_id]:
-            reply_data.write(encode_location(location))
+        if encoding == LocationDataEncoding.QUANTIZED_DELTA_U16:
+            encoded_locations = encode_locations_quantized(locations)
+        else:
+            encoded_locations = encode_locations(locations)
 
-        return encode_reqrep_reply(ReqRepStatusCode.SUCCESS, reply_data.getvalue())
+        return encode_reqrep_reply(
+            ReqRepStatusCode.SUCCESS,
+            encoding.to_bytes(1, BYTE_ORDER) + encoded_locations,
+        )
 
     def _process_prepare_to_render_request(self):
         if not self._rendering:
-            # First call after previous render, reset location data cache
-            self._obj_info_manager.invalidate_rendering_location_data_cache()
+            # First call after previous render, evaluate the trajectories of all frames
+            # in the following ticks, unless they're still valid from a previous render.
+            self._obj_info_manager.start_rendering_trajectory_evaluation()
             self._rendering = True
         return encode_reqrep_reply(ReqRepStatusCode.SUCCESS)
 
     def _process_inform_render_finished_request(self):
         self._rendering = False
+        self._obj_info_manager.stop_rendering_trajectory_evaluation()
+        # Nothing was published while rendering.
+        self._obj_info_manager.request_location_resend()
+        return encode_reqrep_reply(ReqRepStatusCode.SUCCESS)
+
+    def _process_camera_sub_request(self):
+        """Publish CAMERA_MATRIX messages for the next CAMERA_SUB_LEASE_S seconds."""
+        now = time.monotonic()
+        if now >= self._camera_sub_expiry:
+            # A new subscriber needs the current matrix.
+            self._obj_info_manager.camera_matrix_requested = True
+        self._camera_sub_expiry = now + IPCServer.CAMERA_SUB_LEASE_S
         return encode_reqrep_reply(ReqRepStatusCode.SUCCESS)
 
+    def _uses_shared_memory_positions(self, flags: SubFlags) -> bool:
+        return self._shared_positions is not None and bool(
+            flags & SubFlags.SHARED_MEMORY_POSITIONS)
+
+    def _uses_world_space_positions(self, flags: SubFlags) -> bool:
+        return not self._uses_shared_memory_positions(flags) and bool(
+            flags & SubFlags.WORLD_SPACE_POSITIONS)
+
+    def _uses_frame_snapshots(self, flags: SubFlags) -> bool:
+        return (
+            not self._uses_shared_memory_positions(flags)
+            and not self._uses_world_space_positions(flags)
+            and bool(flags & SubFlags.FRAME_SNAPSHOTS)
+        )
+
     def _process_object_sub_request(self, request_data: BytesIO) -> bytes:
         name = decode_object_name(request_data)
+        flags = decode_sub_flags(request_data)
         try:
-            ambilink_id = self._obj_info_manager.register_sub(name)
+            ambilink_id = self._obj_info_manager.register_sub(
+                name,
+                self._uses_shared_memory_positions(flags),
+                self._uses_frame_snapshots(flags),
+                self._uses_world_space_positions(flags),
+            )
             return encode_reqrep_reply(
                 ReqRepStatusCode.SUCCESS, ambilink_id.to_bytes(2, BYTE_ORDER)
             )
@@ -270,20 +647,39 @@ class IPCServer:
 
     def _process_object_unsub_request(self, request_data: BytesIO) -> bytes:
         ambilink_id = decode_ambilink_id(request_data)
+        flags = decode_sub_flags(request_data)
         return encode_reqrep_reply(
             ReqRepStatusCode.SUCCESS
-            if self._obj_info_manager.unregister_sub(ambilink_id)
+            if self._obj_info_manager.unregister_sub(
+                ambilink_id,
+                self._uses_shared_memory_positions(flags),
+                self._uses_frame_snapshots(flags),
+                self._uses_world_space_positions(flags),
+            )
             else ReqRepStatusCode.OBJECT_NOT_FOUND
         )
 
     def _process_object_list_request(self) -> bytes:
         """Build a reply to an object list request."""
-        obj_list = self._obj_info_manager.get_object_name_list()
-        encoded_list = bytes()
-        for obj_name in obj_list:
-            encoded_list += encode_object_name(obj_name)
+        return encode_reqrep_reply(
+            ReqRepStatusCode.SUCCESS, self._obj_info_manager.get_encoded_object_list())
 
-        return encode_reqrep_reply(ReqRepStatusCode.SUCCESS, encoded_list)
+    def _process_object_list_query_request(self, request_data: BytesIO) -> bytes:
+        """Build a reply to an object list query (search + paging) request."""
+        known_version, offset, limit = struct.unpack("=QII", request_data.read(16))
+        query = decode_object_name(request_data)
+        version, matches = self._obj_info_manager.query_object_list(query)
+
+        if version == known_version:
+            return encode_reqrep_reply(
+                ReqRepStatusCode.SUCCESS, struct.pack("=QB", version, True))
+
+        page = matches[offset:offset + limit]
+        return encode_reqrep_reply(
+            ReqRepStatusCode.SUCCESS,
+            struct.pack("=QBI", version, False, len(matches))
+            + encode_object_name_list(page),
+        )
 
     def _publish(self):
         """Publish all queued messages using the Pub0 socket."""
@@ -292,6 +688,19 @@ class IPCServer:
             self._pub_sock.send(msg)
 
 
+def get_publish_thresholds(context) -> PublishThresholds:
+    """Get the publish thresholds from the add-on preferences, defaults for unset ones."""
+    preferences = context.preferences.addons['ambilink'].preferences
+    defaults = PublishThresholds()
+    return PublishThresholds(*(
+        preferences.get(name, default)
+        for name, default in zip(
+            ("publish_threshold_deg", "publish_threshold_db", "publish_max_interval"),
+            defaults,
+        )
+    ))
+
+
 class StartServerOp(bpy.types.Operator):
     """Starts"""
 
@@ -352,7 +761,7 @@ class StartServerOp(bpy.types.Operator):
         self._timer = context.window_manager.event_timer_add(
             1.0 / tickrate, window=context.window
         )
-        self._ipc_bridge = IPCServer(context)
+        self._ipc_bridge = IPCServer(context, get_publish_thresholds(context))
         StartServerOp.is_running = True
         context.window_manager.modal_handler_add(self)
         self.report({"INFO"}, "Started Ambilink server.")
@@ -360,7 +769,7 @@ class StartServerOp(bpy.types.Operator):
 
     def cancel(self, context):
         context.window_manager.event_timer_remove(self._timer)
-        self._ipc_bridge.close_sockets()
+        self._ipc_bridge.stop()
         self._ipc_bridge = None
         StartServerOp.is_running = False
         StartServerOp.should_stop = False
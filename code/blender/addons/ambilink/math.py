@@ -1,17 +1,28 @@
+import math
 import bpy
 import mathutils
 
-def get_object_location_camera_space(
-    object_location: mathutils.Vector,
-    camera: bpy.types.Object,
-) -> mathutils.Vector:
-    """Calc camera space position for an object and a camera (Z-axis points forward)"""
+def get_view_matrix(camera: bpy.types.Object) -> mathutils.Matrix:
+    """Calc the matrix transforming world space locations to camera space (Z-axis points forward)"""
     view_m = camera.matrix_world.inverted()
     # TODO: camera scale messes things up
 
-    loc = view_m @ object_location
-    loc.z = (
-        -loc.z
-    )  # invert the Z-axis to point forward (a matter of personal preference)
+    # invert the Z-axis to point forward (a matter of personal preference)
+    view_m[2] = -view_m[2]
+    return view_m
+
+def get_location_camera_space(
+    object_location: mathutils.Vector,
+    view_matrix: mathutils.Matrix,
+) -> mathutils.Vector:
+    """Calc camera space position for an object using a matrix from `get_view_matrix`"""
+    return view_matrix @ object_location
+
+def get_direction_change_deg(a: mathutils.Vector, b: mathutils.Vector) -> float:
+    """Calc the angle between the directions of two listener-relative locations in degrees"""
+    return math.degrees(a.angle(b, 0.0))
 
-    return loc
+def get_distance_gain_change_db(a: mathutils.Vector, b: mathutils.Vector) -> float:
+    """Calc the change of the inverse distance law gain between two listener-relative locations in dB"""
+    min_distance = 1e-6
+    return abs(20.0 * math.log10(max(a.length, min_distance) / max(b.length, min_distance)))
@@ -1,8 +1,16 @@
-from typing import Callable, Dict, List, Tuple
+import time
+from typing import Callable, Dict, List, NamedTuple, Optional, Tuple
 import bpy
 import mathutils
-from ambilink.utils import Memoized
-from ambilink.math import get_object_location_camera_space
+import numpy as np
+from ambilink.math import (
+    get_direction_change_deg,
+    get_distance_gain_change_db,
+    get_location_camera_space,
+    get_view_matrix,
+)
+from ambilink.object_list import ObjectListTracker
+from ambilink.trajectories import RenderingTrajectories
 
 
 class ObjectNotFoundError(Exception):
@@ -89,19 +97,27 @@ class ObjectInfo:
                 "ObjectInfo.on_rename called, but the object has been deleted."
             ) from exc
 
-    def get_location_camera_space(self, camera: bpy.types.Camera):
+    def get_location(self) -> mathutils.Vector:
+        """Gets object location in world space.
+
+        Raises:
+            ObjectDeletedError: If the referenced object has been deleted
+        """
+        return self._get_reference_property("location").copy()
+
+    def get_location_camera_space(self, view_matrix: mathutils.Matrix):
         """Gets object location in camera space (Z-axis points forward).
 
         Args:
-            camera (bpy.types.Camera): _description_
+            view_matrix (mathutils.Matrix): camera's view matrix, see `math.get_view_matrix`
         Raises:
             ObjectDeletedError: If the referenced object has been deleted
 
         Returns:
             mathutils.Vector: object location camera space
         """
-        return get_object_location_camera_space(
-            self._get_reference_property("location"), camera
+        return get_location_camera_space(
+            self._get_reference_property("location"), view_matrix
         )
 
     def reassign_object_ref(self, obj: bpy.types.Object):
@@ -129,6 +145,54 @@ class ObjectInfo:
                 pass
 
 
+class PublishThresholds(NamedTuple):
+    """Changes of an object's location relative to the listener below which updates
+    aren't published, VST instances interpolate between the updates they receive."""
+    direction_deg: float = 1.0
+    distance_db: float = 1.0
+    # Locations are republished after this many seconds even if they didn't change,
+    # as a keepalive that also corrects VST extrapolation overshooting a stopped object.
+    max_interval_s: float = 0.5
+
+
+class PublishedLocation:
+    """Tracks the location last published to a group of subscribers of an object."""
+
+    def __init__(self) -> None:
+        # None if the next location must be published.
+        self.location: Optional[mathutils.Vector] = None
+        self.time = 0.0
+
+    def reset(self):
+        """Make the next `should_publish` call return True."""
+        self.location = None
+
+    def should_publish(
+        self,
+        location: mathutils.Vector,
+        now: float,
+        thresholds: PublishThresholds,
+        listener_location: Optional[mathutils.Vector] = None,
+    ) -> bool:
+        """Check if `location` differs enough from the published location, as seen from
+        `listener_location` (the origin if None), or `thresholds.max_interval_s` passed
+        since it was published. Records it as published if so."""
+        if self.location is not None and now - self.time < thresholds.max_interval_s:
+            if self.location == location:
+                return False
+            prev, curr = self.location, location
+            if listener_location is not None:
+                prev, curr = prev - listener_location, curr - listener_location
+            if (
+                get_direction_change_deg(prev, curr) < thresholds.direction_deg
+                and get_distance_gain_change_db(prev, curr) < thresholds.distance_db
+            ):
+                return False
+        self.location = location
+        self.time = now
+        return True
+
+
 class ObjectInfoManager:
     """
     Manages a list of objects that VST instances have subscribed to
@@ -141,18 +205,89 @@ class ObjectInfoManager:
         def __init__(self, obj_info: ObjectInfo, sub_count: int = 1) -> None:
             self.obj_info = obj_info
             self.sub_count = sub_count
+            # Number of subscribers reading positions from shared memory.
+            self.shared_memory_sub_count = 0
+            # Number of subscribers receiving positions in FRAME_SNAPSHOT messages.
+            self.frame_snapshot_sub_count = 0
+            # Number of subscribers receiving world space positions in WORLD_SNAPSHOT messages.
+            self.world_space_sub_count = 0
+            # Camera space location last published in OBJ_POSITION_UPDATED or FRAME_SNAPSHOT messages.
+            self.published_camera_space_location = PublishedLocation()
+            # World space location last published in a WORLD_SNAPSHOT.
+            self.published_world_space_location = PublishedLocation()
+
+        def has_shared_memory_subscribers(self) -> bool:
+            """True if position updates must be written to shared memory."""
+            return self.shared_memory_sub_count > 0
+
+        def has_frame_snapshot_subscribers(self) -> bool:
+            """True if position updates must be included in FRAME_SNAPSHOT messages."""
+            return self.frame_snapshot_sub_count > 0
+
+        def has_world_space_subscribers(self) -> bool:
+            """True if moves must be included in WORLD_SNAPSHOT messages."""
+            return self.world_space_sub_count > 0
+
+        def has_camera_space_subscribers(self) -> bool:
+            """True if the camera space location must be computed every tick."""
+            return self.sub_count > self.world_space_sub_count
+
+        def has_pubsub_subscribers(self) -> bool:
+            """True if position updates must be published as OBJ_POSITION_UPDATED messages."""
+            return self.sub_count > (
+                self.shared_memory_sub_count
+                + self.frame_snapshot_sub_count
+                + self.world_space_sub_count
+            )
+
+        def add_sub(
+            self,
+            shared_memory_positions: bool,
+            frame_snapshots: bool,
+            world_space_positions: bool = False,
+            count: int = 1,
+        ):
+            """Changes the subscriber counts by `count`."""
+            self.sub_count += count
+            if shared_memory_positions:
+                self.shared_memory_sub_count += count
+            elif world_space_positions:
+                self.world_space_sub_count += count
+                # A new subscriber needs the current location.
+                self.published_world_space_location.reset()
+                return
+            elif frame_snapshots:
+                self.frame_snapshot_sub_count += count
+            self.published_camera_space_location.reset()
 
         def __iter__(self):
             return iter((self.obj_info, self.sub_count))
 
     def __init__(self, rename_cb, delete_cb, context) -> None:
         self._registered_objects: Dict[int, ObjectInfoManager.RegisteredObject] = {}
+        self._object_list_tracker = ObjectListTracker()
+        # Changes whenever the rendering location data of subscribed objects may have changed.
+        # Unique per server session, so VST instances never reuse data from a previous session.
+        self.animation_revision = time.time_ns()
+        self._rendering_cache_revision = self.animation_revision
+        # Locations of the registered objects for all frames, None if invalidated.
+        self._rendering_trajectories: Optional[RenderingTrajectories] = None
+        self._scene_signature = None
+        # Set while frames are evaluated for rendering, the resulting depsgraph updates
+        # don't change the animation.
+        self._evaluating_rendering_frames = False
+        # Current frame before rendering frames started being evaluated, restored once
+        # they all have been, None if no evaluation is in progress.
+        self._frame_before_evaluation: Optional[int] = None
+        # Set when world space subscribers need the camera matrix even if the camera didn't move.
+        self.camera_matrix_requested = True
         self.set_context(context)
         ObjectInfo.rename_cb = rename_cb
         ObjectInfo.delete_cb = delete_cb
         ObjectInfo.clear_ambilink_ids()
         bpy.app.handlers.undo_post.append(self._on_undo_redo_post)
         bpy.app.handlers.redo_post.append(self._on_undo_redo_post)
+        bpy.app.handlers.depsgraph_update_post.append(self._on_depsgraph_update_post)
 
     def __hash__(self) -> int:
         return id(self)
@@ -194,12 +329,85 @@ class ObjectInfoManager:
         for ambilink_id in deleted_object_ids:
             self._registered_objects.pop(ambilink_id)
 
-    def get_object_name_list(self) -> List[str]:
-        """Get a list of names of all objects in the scene"""
-        return [obj.name for obj in self._context.scene.objects]
+    @staticmethod
+    def _get_scene_signature(scene: bpy.types.Scene) -> tuple:
+        """Scene settings that rendering location data depends on."""
+        return (
+            scene.frame_start,
+            scene.frame_end,
+            scene.frame_step,
+            scene.render.fps,
+            scene.render.fps_base,
+            scene.camera.name if scene.camera is not None else None,
+        )
+
+    def _on_depsgraph_update_post(self, scene: bpy.types.Scene, depsgraph):
+        """Bumps `animation_revision` if the camera, a subscribed object,
+        an action or the frame range may have changed."""
+        if self._evaluating_rendering_frames:
+            return
+
+        scene_signature = ObjectInfoManager._get_scene_signature(scene)
+        changed = scene_signature != self._scene_signature or depsgraph.id_type_updated("ACTION")
+        self._scene_signature = scene_signature
+
+        if not changed:
+            tracked_names = {reg_obj.obj_info.name for reg_obj in self._registered_objects.values()}
+            if scene.camera is not None:
+                tracked_names.add(scene.camera.name)
+            changed = any(
+                update.is_updated_transform
+                and isinstance(update.id, bpy.types.Object)
+                and update.id.original.name in tracked_names
+                for update in depsgraph.updates
+            )
 
-    def register_sub(self, object_name: str) -> int:
+        if changed:
+            self.animation_revision += 1
+
+    def stop(self):
+        """Unregisters Blender handlers, must be called when the server is stopped."""
+        self._object_list_tracker.stop()
+        for handlers, handler in (
+            (bpy.app.handlers.undo_post, self._on_undo_redo_post),
+            (bpy.app.handlers.redo_post, self._on_undo_redo_post),
+            (bpy.app.handlers.depsgraph_update_post, self._on_depsgraph_update_post),
+        ):
+            if handler in handlers:
+                handlers.remove(handler)
+
+    def get_encoded_object_list(self) -> bytes:
+        """Get the names of all objects in the scene, encoded for an OBJ_LIST reply
+        (see `ObjectListTracker.get_encoded_names`)."""
+        self._object_list_tracker.update(self._context.scene)
+        return self._object_list_tracker.get_encoded_names()
+
+    def get_current_encoded_object_list(self) -> Optional[bytes]:
+        """See `ObjectListTracker.get_current_encoded_names`, safe to call from any thread."""
+        return self._object_list_tracker.get_current_encoded_names()
+
+    def query_object_list(self, query: str) -> Tuple[int, List[str]]:
+        """Get the current object list version and the names of objects matching `query`
+        (see `ObjectListTracker.query`)."""
+        self._object_list_tracker.update(self._context.scene)
+        return (self._object_list_tracker.version, self._object_list_tracker.query(query))
+
+    def is_object_list_unchanged_since(self, known_version: int) -> bool:
+        """See `ObjectListTracker.is_unchanged_since`, safe to call from any thread."""
+        return self._object_list_tracker.is_unchanged_since(known_version)
+
+    def register_sub(
+        self,
+        object_name: str,
+        shared_memory_positions: bool = False,
+        frame_snapshots: bool = False,
+        world_space_positions: bool = False,
+    ) -> int:
         """Adds an object to the list of object for which updates are published.
+        If `shared_memory_positions` is True, the subscriber reads positions from shared memory,
+        otherwise if `world_space_positions` is True, it receives world space positions in
+        WORLD_SNAPSHOT messages, otherwise if `frame_snapshots` is True, it receives them in
+        FRAME_SNAPSHOT messages.
         Raises:
             ObjectNotFoundError: object with the given name could not be found.
         Returns:
@@ -214,25 +422,36 @@ class ObjectInfoManager:
             if self._registered_objects.get(ambilink_id) is None:
                 ObjectInfo.clear_ambilink_id(obj)
             else:
-                self._registered_objects[ambilink_id].sub_count += 1
+                self._registered_objects[ambilink_id].add_sub(
+                    shared_memory_positions, frame_snapshots, world_space_positions)
+                self.camera_matrix_requested |= world_space_positions
                 return ambilink_id
         # object doesn't have any subscribers yet
         obj_info = ObjectInfo(obj)
-        self._registered_objects[
-            obj_info.ambilink_id
-        ] = ObjectInfoManager.RegisteredObject(obj_info, 1)
+        registered_obj = ObjectInfoManager.RegisteredObject(obj_info, 0)
+        registered_obj.add_sub(shared_memory_positions, frame_snapshots, world_space_positions)
+        self.camera_matrix_requested |= world_space_positions
+        self._registered_objects[obj_info.ambilink_id] = registered_obj
         self.invalidate_rendering_location_data_cache()
         return obj_info.ambilink_id
 
-    def unregister_sub(self, ambilink_id: int) -> bool:
+    def unregister_sub(
+        self,
+        ambilink_id: int,
+        shared_memory_positions: bool = False,
+        frame_snapshots: bool = False,
+        world_space_positions: bool = False,
+    ) -> bool:
         """Decreases object subscriber count, if sub count reaches 0,
         the object is removed from the list of object for which updates are published.
+        The flags must match the values passed to `register_sub`.
 
         Returns:
             bool: true if subscribed object was found, false otherwise
         """
         try:
-            self._registered_objects[ambilink_id].sub_count -= 1
+            self._registered_objects[ambilink_id].add_sub(
+                shared_memory_positions, frame_snapshots, world_space_positions, -1)
             if self._registered_objects[ambilink_id].sub_count == 0:
                 self._registered_objects[
                     ambilink_id
@@ -243,53 +462,124 @@ class ObjectInfoManager:
         except KeyError:
             return False
 
-    @Memoized
-    def get_rendering_location_data_for_registered_objects(
-        self, start_frame: int, end_frame: int
-    ) -> Dict[int, List[mathutils.Vector]]:
-        """Gets the location of an object at the specified time in the animation.
+    def _get_rendering_trajectories(self) -> RenderingTrajectories:
+        """Get the rendering trajectories, creating them if they were invalidated."""
+        if self._rendering_trajectories is None:
+            frame_count, _ = self.get_animation_info()
+            self._rendering_trajectories = RenderingTrajectories(
+                self._registered_objects.keys(), frame_count)
+        return self._rendering_trajectories
+
+    def start_rendering_trajectory_evaluation(self):
+        """Prepare the rendering trajectories of all registered objects for evaluation
+        by `evaluate_rendering_trajectories`, keeping those already evaluated if the animation
+        didn't change since. Should be called before a new render is started."""
+        self.invalidate_outdated_rendering_location_data_cache()
+        self._get_rendering_trajectories()
+
+    def stop_rendering_trajectory_evaluation(self):
+        """Restore the current frame if rendering frames are still being evaluated.
+        Should be called when a render is finished."""
+        if self._frame_before_evaluation is None:
+            return
+        self._evaluating_rendering_frames = True
+        try:
+            self._context.scene.frame_set(self._frame_before_evaluation)
+        finally:
+            self._frame_before_evaluation = None
+            self._evaluating_rendering_frames = False
+
+    def evaluate_rendering_trajectories(
+        self, time_budget_s: Optional[float] = None, end_frame: Optional[int] = None
+    ):
+        """Evaluate frames of the rendering trajectories in order, until `end_frame`
+        (the last frame if None) has been evaluated, or `time_budget_s` has been used up."""
+        trajectories = self._get_rendering_trajectories()
+        if end_frame is None:
+            end_frame = trajectories.frame_count - 1
+        if trajectories.evaluated_frame_count > end_frame:
+            return
+
+        scene = self._context.scene
+        camera = scene.camera
+        if camera is None:
+            while trajectories.evaluated_frame_count <= end_frame:
+                trajectories.add_next_frame({})
+            return
+
+        deadline = None if time_budget_s is None else time.monotonic() + time_budget_s
+        if self._frame_before_evaluation is None:
+            self._frame_before_evaluation = scene.frame_current
+        # Frames evaluated in the next ticks continue from the current one,
+        # so the frame is only restored once all frames have been evaluated.
+        restore_frame = True
+        self._evaluating_rendering_frames = True
+        try:
+            while trajectories.evaluated_frame_count <= end_frame:
+                scene.frame_set(
+                    scene.frame_start + trajectories.evaluated_frame_count * scene.frame_step)
+                view_matrix = get_view_matrix(camera)
+                trajectories.add_next_frame({
+                    ambilink_id: registered_obj.obj_info.get_location_camera_space(view_matrix)
+                    for ambilink_id in trajectories.ambilink_ids
+                    if (registered_obj := self._registered_objects.get(ambilink_id)) is not None
+                })
+                if deadline is not None and time.monotonic() >= deadline:
+                    break
+            restore_frame = trajectories.is_complete()
+        finally:
+            if restore_frame:
+                scene.frame_set(self._frame_before_evaluation)
+                self._frame_before_evaluation = None
+            self._evaluating_rendering_frames = False
+
+    def is_rendering_trajectory_evaluation_pending(self) -> bool:
+        """Check if `evaluate_rendering_trajectories` has frames left to evaluate."""
+        trajectories = self._rendering_trajectories
+        return trajectories is not None and not trajectories.is_complete()
+
+    def get_rendering_location_data(
+        self, ambilink_id: int, start_frame: int, end_frame: int
+    ) -> Optional[np.ndarray]:
+        """Get the camera space locations of a registered object for each frame
+        from `start_frame` to `end_frame` (inclusive), evaluating the frames
+        that haven't been evaluated yet.
 
         Raises:
-            ObjectNotFoundError: if `ambilink_id` doesn't correspond to a registered object
             ValueError: start_frame or end_frame were invalid
 
         Returns:
-            Dict[int, List[mathutils.Vector]]: locations for all registered objects
-                                               for each frame in specified interval.
+            Optional[np.ndarray]: (frame count, 3) array of locations,
+                                  None if `ambilink_id` doesn't correspond to a registered object.
         """
-        scene = self._context.scene
-        scene_frame_count, _ = self.get_animation_info()
-        initial_frame = scene.frame_current
-
-        if start_frame < 0 or end_frame > scene_frame_count or end_frame < start_frame:
+        trajectories = self._get_rendering_trajectories()
+        if start_frame < 0 or end_frame >= trajectories.frame_count or end_frame < start_frame:
             raise ValueError("Invalid start or end frame")
-
-        camera = scene.camera
-        if camera is None:
-            return [
-                mathutils.Vector((0, 0, 0)) for _ in range(start_frame, end_frame + 1)
-            ]
-
-        retval: Dict[int, List(mathutils.Vector)] = {
-            ambilink_id: [] for ambilink_id in self._registered_objects
-        }
-
-        real_start_frame = scene.frame_start + start_frame * scene.frame_step
-        real_end_frame = scene.frame_start + end_frame * scene.frame_step
-
-        for frame in range(
-            real_start_frame, real_end_frame + 1, scene.frame_step
-        ):
-            scene.frame_set(frame)
-            for ambilink_id, reg_obj in self._registered_objects.items():
-                retval[ambilink_id].append(reg_obj.obj_info.get_location_camera_space(camera))
-
-        scene.frame_set(initial_frame)
-        return retval
+        if not trajectories.has_object(ambilink_id):
+            return None
+
+        self.evaluate_rendering_trajectories(end_frame=end_frame)
+        return trajectories.get_locations(ambilink_id, start_frame, end_frame)
+
+    def get_evaluated_rendering_location_data(
+        self, ambilink_id: int, start_frame: int, end_frame: int
+    ) -> Optional[np.ndarray]:
+        """Same as `get_rendering_location_data`, but None if any of the frames hasn't been
+        evaluated yet. Doesn't access bpy, so it's safe to call from any thread."""
+        trajectories = self._rendering_trajectories
+        if trajectories is None or start_frame < 0 or end_frame < start_frame:
+            return None
+        return trajectories.get_locations(ambilink_id, start_frame, end_frame)
 
     def invalidate_rendering_location_data_cache(self):
-        """Invalidates the rendering data cache, should be called before new render is started."""
-        ObjectInfoManager.get_rendering_location_data_for_registered_objects.invalidate_cache() # pylint: disable=no-member
+        """Discards the rendering trajectories."""
+        self._rendering_trajectories = None
+        self._rendering_cache_revision = self.animation_revision
+
+    def invalidate_outdated_rendering_location_data_cache(self):
+        """Discards the rendering trajectories if the animation changed since they were created."""
+        if self._rendering_cache_revision != self.animation_revision:
+            self.invalidate_rendering_location_data_cache()
 
     def get_animation_info(self) -> Tuple[int, float]:
         """Returns a tuple of (frame_count, fps) for the curr scene."""
@@ -298,17 +588,46 @@ class ObjectInfoManager:
         fps = scene.render.fps / scene.render.fps_base
         return (frame_count, fps)
 
-    def get_updated_object_locations(self) -> List[Tuple[int, mathutils.Vector]]:
-        """Get object locations for all registered objects"""
+    def get_view_matrix(self) -> Optional[mathutils.Matrix]:
+        """Get the active camera's view matrix (see `math.get_view_matrix`),
+        None if the scene has no camera."""
         camera = self._context.scene.camera
         if camera is None:
+            return None
+        return get_view_matrix(camera)
+
+    def get_camera_location(self) -> Optional[mathutils.Vector]:
+        """Get the active camera's world space location, None if the scene has no camera."""
+        camera = self._context.scene.camera
+        if camera is None:
+            return None
+        return camera.matrix_world.translation
+
+    def request_location_resend(self):
+        """Make the next tick publish the camera matrix and the locations of all objects,
+        e.g. after a render during which nothing was published."""
+        self.camera_matrix_requested = True
+        for registered_obj in self._registered_objects.values():
+            registered_obj.published_camera_space_location.reset()
+            registered_obj.published_world_space_location.reset()
+
+    def get_updated_object_locations(
+        self,
+    ) -> List[Tuple[int, mathutils.Vector, "ObjectInfoManager.RegisteredObject"]]:
+        """Get world space object locations for all registered objects,
+        along with the RegisteredObject (to check how updates must be delivered)."""
+        if self._context.scene.camera is None:
             return []
 
         retval = []
         deleted_object_ids = []
-        for ambilink_id, [obj_info, _] in self._registered_objects.items():
+        for ambilink_id, registered_obj in self._registered_objects.items():
             try:
-                retval.append((ambilink_id, obj_info.get_location_camera_space(camera)))
+                retval.append((
+                    ambilink_id,
+                    registered_obj.obj_info.get_location(),
+                    registered_obj,
+                ))
             except ObjectDeletedError:
                 deleted_object_ids.append(ambilink_id)
         for ambilink_id in deleted_object_ids:
@@ -0,0 +1,133 @@
+import sys
+import time
+from typing import Dict, List, Optional
+import bpy
+
+
+def encode_object_name(name: str) -> bytes:
+    """Encode object name as [1 byte|`obj_name_length`] [`obj_name_length` bytes|`obj_name[]`]"""
+    encoded_name = name.encode("utf8")
+    # Max Blender object name length is 63 chars, so 1 byte is enough
+    # even if all symbols take up 4 bytes in utf8 (max byte count per code point).
+    return len(encoded_name).to_bytes(1, sys.byteorder) + encoded_name
+
+
+class ObjectListTracker:
+    """
+    Keeps track of the names of all objects in the scene and versions them,
+    so VST instances can be sent only the page of names matching a search query they display,
+    and nothing if it didn't change since the version they already have.
+    The list is only rescanned after Blender reports a change that may affect it.
+    The encoded list sent in OBJ_LIST replies is kept up to date as well,
+    only the names that changed are encoded again.
+    """
+
+    # Number of search queries for which the matches are cached.
+    MAX_CACHED_QUERIES = 16
+
+    def __init__(self) -> None:
+        # Unique per server session, so versions from a previous session never match.
+        self.version = time.time_ns()
+        self._names: Dict[int, str] = {}
+        self._dirty = True
+        self._msgbus_owner = object()
+        # Matching names per search query, for the current version only.
+        self._query_cache: Dict[str, List[str]] = {}
+        # Names encoded with `encode_object_name` by object pointer, in scene order.
+        self._encoded_names: Dict[int, bytes] = {}
+        # Concatenation of `_encoded_names`.
+        self._encoded_list = b""
+
+        bpy.app.handlers.depsgraph_update_post.append(self._on_depsgraph_update)
+        bpy.app.handlers.undo_post.append(self._on_undo_redo_post)
+        bpy.app.handlers.redo_post.append(self._on_undo_redo_post)
+        bpy.msgbus.subscribe_rna(
+            key=(bpy.types.Object, "name"),
+            owner=self._msgbus_owner,
+            args=(),
+            notify=self.mark_dirty,
+        )
+
+    def stop(self):
+        """Unregisters Blender handlers, must be called before the tracker is discarded."""
+        bpy.msgbus.clear_by_owner(self._msgbus_owner)
+        for handlers in (
+            bpy.app.handlers.depsgraph_update_post,
+            bpy.app.handlers.undo_post,
+            bpy.app.handlers.redo_post,
+        ):
+            for handler in (self._on_depsgraph_update, self._on_undo_redo_post):
+                if handler in handlers:
+                    handlers.remove(handler)
+
+    def mark_dirty(self, *_):
+        """Schedule a rescan of the object list before the next query."""
+        self._dirty = True
+
+    def _on_depsgraph_update(self, _scene, depsgraph):
+        # Objects being added to or removed from the scene always update a collection.
+        if depsgraph.id_type_updated("COLLECTION") or depsgraph.id_type_updated("SCENE"):
+            self._dirty = True
+
+    def _on_undo_redo_post(self, *_):
+        self._dirty = True
+
+    def update(self, scene: bpy.types.Scene):
+        """Rescan the scene's objects if anything may have changed, and bump the version
+        if they did."""
+        if not self._dirty:
+            return
+
+        names = {obj.as_pointer(): obj.name for obj in scene.objects}
+        changed = {ptr for ptr, name in names.items() if self._names.get(ptr) != name}
+        removed = self._names.keys() - names.keys()
+
+        self._names = names
+        if changed or removed:
+            self.version += 1
+            self._query_cache = {}
+            self._encoded_names = {
+                ptr: encode_object_name(name) if ptr in changed else self._encoded_names[ptr]
+                for ptr, name in names.items()
+            }
+            self._encoded_list = b"".join(self._encoded_names.values())
+        # Only cleared once the new version and list are published, the request thread
+        # must not answer from the previous ones.
+        self._dirty = False
+
+    def is_unchanged_since(self, known_version: int) -> bool:
+        """Check if `known_version` is the current version and no change is pending.
+        Doesn't access bpy, so it's safe to call from any thread."""
+        return not self._dirty and known_version == self.version
+
+    def get_encoded_names(self) -> bytes:
+        """Names of all objects in the scene as of the last update,
+        encoded with `encode_object_name` and concatenated."""
+        return self._encoded_list
+
+    def get_current_encoded_names(self) -> Optional[bytes]:
+        """Same as `get_encoded_names`, but None if a change is pending.
+        Doesn't access bpy, so it's safe to call from any thread."""
+        return None if self._dirty else self._encoded_list
+
+    def query(self, query: str) -> List[str]:
+        """Get names containing `query` (case-insensitive), ordered by
+        the position of the match, then by the order in the scene."""
+        if (matches := self._query_cache.get(query)) is not None:
+            return matches
+
+        if query:
+            query_lower = query.lower()
+            indexed_matches = []
+            for name in self._names.values():
+                if (index := name.lower().find(query_lower)) != -1:
+                    indexed_matches.append((index, len(indexed_matches), name))
+            indexed_matches.sort()
+            matches = [name for _, _, name in indexed_matches]
+        else:
+            matches = list(self._names.values())
+
+        if len(self._query_cache) >= ObjectListTracker.MAX_CACHED_QUERIES:
+            self._query_cache.pop(next(iter(self._query_cache)))
+        self._query_cache[query] = matches
+        return matches
@@ -0,0 +1,114 @@
+import logging
+import mmap
+import os
+import struct
+import time
+from typing import Optional
+import mathutils
+
+try:
+    import _posixshmem
+except ImportError:
+    # Not available on Windows
+    _posixshmem = None
+
+
+class SharedPositionWriter:
+    """
+    Writes object positions into a POSIX shared memory segment,
+    which VST instances read directly instead of receiving position updates via Pub/Sub.
+
+    Layout (must match IPC/SharedPositions.h in the VST):
+        header: [4 bytes|magic] [2 bytes|layout version] [2 bytes|reserved]
+                [4 bytes|slot count] [52 bytes|reserved]
+        slot_count slots, indexed by ambilink id:
+                [4 bytes|seq] [4 bytes|check] [3 floats|camera space location]
+                [4 bytes|reserved] [8 bytes|unix time in ns]
+
+    Slots are protected by a seqlock - `seq` is odd while a slot is being written.
+    `check` is the XOR of the final `seq` and the data words, so VST instances can detect
+    torn reads even though stores from Python aren't ordered by memory barriers.
+    """
+
+    SHM_NAME = "/ambilink_positions"
+    MAGIC = 0x4C424D41  # "AMBL"
+    LAYOUT_VERSION = 1
+    # Ambilink ids are 16 bit
+    SLOT_COUNT = 1 << 16
+
+    _HEADER = struct.Struct("=IHHI52x")
+    _SEQ = struct.Struct("=I")
+    _SLOT_DATA = struct.Struct("=IfffIQ")
+    _SLOT_SIZE = 32
+    _SLOT_DATA_WORDS = struct.Struct("=5I")
+    _SLOT_DATA_VALUES = struct.Struct("=fffQ")
+    _SEGMENT_SIZE = _HEADER.size + SLOT_COUNT * _SLOT_SIZE
+
+    def __init__(self) -> None:
+        if _posixshmem is None:
+            raise OSError("POSIX shared memory is not supported on this platform.")
+
+        # Segment left over from a session that wasn't stopped properly.
+        try:
+            _posixshmem.shm_unlink(SharedPositionWriter.SHM_NAME)
+        except FileNotFoundError:
+            pass
+
+        fd = _posixshmem.shm_open(
+            SharedPositionWriter.SHM_NAME, os.O_CREAT | os.O_EXCL | os.O_RDWR, mode=0o600
+        )
+        try:
+            os.ftruncate(fd, SharedPositionWriter._SEGMENT_SIZE)
+            self._mmap = mmap.mmap(fd, SharedPositionWriter._SEGMENT_SIZE)
+        finally:
+            os.close(fd)
+
+        SharedPositionWriter._HEADER.pack_into(
+            self._mmap,
+            0,
+            SharedPositionWriter.MAGIC,
+            SharedPositionWriter.LAYOUT_VERSION,
+            0,
+            SharedPositionWriter.SLOT_COUNT,
+        )
+
+    @classmethod
+    def try_create(cls) -> Optional["SharedPositionWriter"]:
+        """Create the shared memory segment, returns None if that's not possible."""
+        try:
+            return cls()
+        except OSError as err:
+            logging.info("Shared memory position updates disabled: %s", err)
+            return None
+
+    def write(self, ambilink_id: int, location: mathutils.Vector):
+        """Write the camera space location of an object into its slot."""
+        offset = SharedPositionWriter._HEADER.size + ambilink_id * SharedPositionWriter._SLOT_SIZE
+        (seq,) = SharedPositionWriter._SEQ.unpack_from(self._mmap, offset)
+        writing_seq = ((seq + 1) & 0xFFFFFFFF) | 1
+        # 0 means the slot has never been written
+        final_seq = ((writing_seq + 1) & 0xFFFFFFFF) or 2
+
+        timestamp_ns = time.time_ns()
+        check = final_seq
+        for word in SharedPositionWriter._SLOT_DATA_WORDS.unpack(
+            SharedPositionWriter._SLOT_DATA_VALUES.pack(
+                location.x, location.y, location.z, timestamp_ns
+            )
+        ):
+            check ^= word
+
+        SharedPositionWriter._SEQ.pack_into(self._mmap, offset, writing_seq)
+        SharedPositionWriter._SLOT_DATA.pack_into(
+            self._mmap, offset + 4, check, location.x, location.y, location.z, 0, timestamp_ns
+        )
+        SharedPositionWriter._SEQ.pack_into(self._mmap, offset, final_seq)
+
+    def close(self):
+        """Unmap and remove the segment. VST instances that have it mapped keep
+        reading the last written positions until they notice the server is gone."""
+        self._mmap.close()
+        try:
+            _posixshmem.shm_unlink(SharedPositionWriter.SHM_NAME)
+        except FileNotFoundError:
+            pass
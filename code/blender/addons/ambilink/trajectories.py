@@ -0,0 +1,55 @@
+from typing import Dict, Iterable, Optional, Sequence
+import numpy as np
+
+
+class RenderingTrajectories:
+    """
+    Camera space locations of the registered objects for every frame of the animation,
+    stored in a frame-indexed array, so location data requests for any frame range are
+    served by slicing it.
+    Frames are evaluated in order by the main thread, possibly over several ticks.
+    Reading frames that have already been evaluated doesn't access bpy,
+    so it's safe from any thread.
+    """
+
+    def __init__(self, ambilink_ids: Iterable[int], frame_count: int) -> None:
+        self._indices: Dict[int, int] = {
+            ambilink_id: index for index, ambilink_id in enumerate(ambilink_ids)
+        }
+        # Indexed by [frame, object index, axis].
+        self._locations = np.zeros((frame_count, len(self._indices), 3), dtype=np.float32)
+        # Frames before this one have been evaluated.
+        self.evaluated_frame_count = 0
+
+    @property
+    def frame_count(self) -> int:
+        return self._locations.shape[0]
+
+    @property
+    def ambilink_ids(self) -> Iterable[int]:
+        return self._indices.keys()
+
+    def is_complete(self) -> bool:
+        return self.evaluated_frame_count == self.frame_count
+
+    def has_object(self, ambilink_id: int) -> bool:
+        return ambilink_id in self._indices
+
+    def add_next_frame(self, locations: Dict[int, Sequence[float]]):
+        """Store the locations for the frame after the last evaluated one,
+        objects missing from `locations` are left at the origin."""
+        frame = self._locations[self.evaluated_frame_count]
+        for ambilink_id, location in locations.items():
+            frame[self._indices[ambilink_id]] = location
+        # Only published after the frame is written, for readers on other threads.
+        self.evaluated_frame_count += 1
+
+    def get_locations(
+        self, ambilink_id: int, start_frame: int, end_frame: int
+    ) -> Optional[np.ndarray]:
+        """Get the locations of an object from `start_frame` to `end_frame` (inclusive)
+        as a (frame count, 3) array, None if the frames haven't been evaluated yet
+        or the object isn't included."""
+        if end_frame >= self.evaluated_frame_count or ambilink_id not in self._indices:
+            return None
+        return self._locations[start_frame:end_frame + 1, self._indices[ambilink_id]]
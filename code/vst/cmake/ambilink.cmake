@@ -37,6 +37,8 @@ juce_add_plugin(${ambilink_target}
 
 # Add sources to target
 file(GLOB_RECURSE ambilink_sources CONFIGURE_DEPENDS ${ambilink_source_dir}/*.h ${ambilink_source_dir}/*.cpp)
+# Sources of the listener plugin, see ambilink_listener.cmake
+list(FILTER ambilink_sources EXCLUDE REGEX "^${ambilink_source_dir}/Listener/")
 target_sources(${ambilink_target} PRIVATE ${ambilink_sources})
 
 target_compile_definitions(
@@ -0,0 +1,62 @@
+# Ambilink Listener - rotates the ambisonic mix of world oriented Ambilink
+# instances to the camera's orientation. Shares the IPC code with the main
+# plugin target, see ambilink.cmake.
+
+set(ambilink_listener_target "ambilink_listener")
+
+juce_add_plugin(${ambilink_listener_target}
+    FORMATS "VST3"
+    PRODUCT_NAME "Ambilink Listener"
+
+    COMPANY_NAME "Ivan Desiatov"
+    COMPANY_WEBSITE "https://github.com/deivse/ambilink"
+
+    PLUGIN_MANUFACTURER_CODE "Ivde"
+    PLUGIN_CODE "Amls"                          # Must differ from the main plugin's code.
+
+    IS_SYNTH "FALSE"
+    NEEDS_MIDI_INPUT "FALSE"
+    NEEDS_MIDI_OUTPUT "FALSE"
+    IS_MIDI_EFFECT "FALSE"
+    EDITOR_WANTS_KEYBOARD_FOCUS "FALSE"
+
+    VST3_CATEGORIES "Spatial" "Surround"
+    COPY_PLUGIN_AFTER_BUILD "FALSE")
+
+file(GLOB_RECURSE ambilink_listener_sources CONFIGURE_DEPENDS ${ambilink_source_dir}/Listener/*.h ${ambilink_source_dir}/Listener/*.cpp)
+target_sources(${ambilink_listener_target}
+    PRIVATE
+        ${ambilink_listener_sources}
+        ${ambilink_source_dir}/IPC/ByteIO.cpp
+        ${ambilink_source_dir}/IPC/MessagePool.cpp
+        ${ambilink_source_dir}/IPC/Protocol.cpp
+        ${ambilink_source_dir}/Math/DirectionFromLocation.cpp
+        ${ambilink_source_dir}/Utility/Utils.cpp)
+
+target_compile_definitions(
+    ${ambilink_listener_target} PUBLIC
+    JUCE_WEB_BROWSER=0
+    JUCE_USE_CURL=0
+    JUCE_DISPLAY_SPLASH_SCREEN=0
+    JUCE_VST3_CAN_REPLACE_VST2=0)
+
+target_include_directories(${ambilink_listener_target}
+    PRIVATE
+        ${ambilink_source_dir}
+        "${CMAKE_SOURCE_DIR}/third-party/nngpp/include")
+
+target_link_libraries(${ambilink_listener_target}
+    PRIVATE
+        juce::juce_audio_utils
+
+        OpenBLAS::OpenBLAS
+        FFTW3::fftw3f
+        fmt::fmt
+        glm::glm
+        spdlog::spdlog
+        saf
+        nngpp
+    PUBLIC
+        juce::juce_recommended_config_flags
+        juce::juce_recommended_lto_flags
+        juce::juce_recommended_warning_flags)
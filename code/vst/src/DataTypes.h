@@ -9,6 +9,8 @@ struct Direction
 {
     float azimuth_deg{0};
     float elevation_deg{0};
+
+    bool operator==(const Direction&) const = default;
 };
 
 using Distance = float;
@@ -18,6 +20,8 @@ struct DirectionWithDistance
 {
     Direction direction{};
     Distance distance{0};
+
+    bool operator==(const DirectionWithDistance&) const = default;
 };
 
 } // namespace ambilink
@@ -93,6 +93,7 @@ BasicEncoder::BasicEncoder(juce::AudioProcessorValueTreeState& params) : _params
       ids::params::distance_attenuation_type.toString());
 
     memset(_prev_weights, 0, sizeof(_prev_weights));
+    memset(_curr_weights, 0, sizeof(_curr_weights));
 }
 
 void BasicEncoder::recalcInterpolatorBuffers(uint16_t frame_size) {
@@ -106,6 +107,44 @@ void BasicEncoder::recalcInterpolatorBuffers(uint16_t frame_size) {
     }
 }
 
+bool BasicEncoder::updateWeightsAndGain(const EncodingParams& params) {
+    if (_curr_params == params) return false;
+    _curr_params = params;
+
+    auto direction = params.source.direction;
+    static_assert(sizeof(Direction) == sizeof(float[2]));
+    getRSH(params.sh_order, reinterpret_cast<float*>(&direction), 1,
+           _curr_weights);
+
+    /* account for normalisation scheme */
+    switch (params.normalization) {
+        case NormalizationType::N3D: /* already N3D, do nothing */
+            break;
+        case NormalizationType::SN3D:
+            juce::FloatVectorOperations::multiply(
+              _curr_weights, _curr_weights, n3d2sn3d,
+              shSignalCountFromOrder(params.sh_order));
+            break;
+    }
+
+    _curr_gain = calculateGainFromDistance(params.source.distance,
+                                           params.dist_att_max_distance,
+                                           params.dist_att_type);
+    return true;
+}
+
+void BasicEncoder::processSteadyState(utils::audio::BufferView<float> buffer,
+                                      uint16_t num_sh_signals) {
+    const auto frame_size = buffer.getNumSamples();
+    const float* input = buffer.getReadPointer(0);
+    // The input is in channel 0, so it must be overwritten last.
+    for (int ch_ix = num_sh_signals - 1; ch_ix > 0; ch_ix--) {
+        buffer.copyFrom(ch_ix, 0, input, frame_size,
+                        _curr_weights[ch_ix] * _curr_gain);
+    }
+    buffer.applyGain(0, _curr_weights[0] * _curr_gain);
+}
+
 void BasicEncoder::process(utils::audio::BufferView<float> buffer) {
     // get weights
     const uint16_t frame_size = buffer.getNumSamples();
@@ -116,28 +155,24 @@ void BasicEncoder::process(utils::audio::BufferView<float> buffer) {
     const uint8_t sh_order_local = _sh_order->load();
     const auto num_sh_signals = shSignalCountFromOrder(sh_order_local);
 
-    float weights[MAX_SH_SIGNALS];
+    const bool weights_changed = updateWeightsAndGain(EncodingParams{
+      .source = {_src_dir_deg, _src_distance},
+      .sh_order = sh_order_local,
+      .normalization
+      = enumFromAudioParamRawValue<NormalizationType>(_normalisation_type),
+      .dist_att_type
+      = enumFromAudioParamRawValue<DistanceAttenuationType>(_dist_att_type),
+      .dist_att_max_distance = _dist_att_max_distance->load()});
 
-    static_assert(sizeof(Direction) == sizeof(float[2]));
-    getRSH(sh_order_local, reinterpret_cast<float*>(&_src_dir_deg), 1, weights);
+    // Previous weights and gain are identical to the current ones, so there
+    // is nothing to interpolate.
+    if (!weights_changed) return processSteadyState(buffer, num_sh_signals);
 
-    float gain = calculateGainFromDistance(
-      _src_distance, *_dist_att_max_distance,
-      enumFromAudioParamRawValue<DistanceAttenuationType>(_dist_att_type));
+    const auto& weights = _curr_weights;
+    const float gain = _curr_gain;
 
     recalcInterpolatorBuffers(frame_size);
 
-    /* account for normalisation scheme */
-    switch (
-      enumFromAudioParamRawValue<NormalizationType>(_normalisation_type)) {
-        case NormalizationType::N3D: /* already N3D, do nothing */
-            break;
-        case NormalizationType::SN3D:
-            juce::FloatVectorOperations::multiply(weights, weights, n3d2sn3d,
-                                                  num_sh_signals);
-            break;
-    }
-
     /**
      * If the ambisonic order changes between calls,
      * some of the _prev_weights may be 0 or values from one of the previous
@@ -150,7 +185,7 @@ void BasicEncoder::process(utils::audio::BufferView<float> buffer) {
       buffer.getReadPointer(0), frame_size, 0.0f,
       reinterpret_cast<float*>(_tmp_frame_prev_coeffs), MAX_FRAME_SIZE);
     cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, num_sh_signals,
-                frame_size, 1, gain, reinterpret_cast<float*>(weights), 1,
+                frame_size, 1, gain, weights, 1,
                 buffer.getReadPointer(0), frame_size, 0.0f,
                 reinterpret_cast<float*>(_tmp_frame_curr_coeffs),
                 MAX_FRAME_SIZE);
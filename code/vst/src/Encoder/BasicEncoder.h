@@ -41,6 +41,19 @@ constexpr uint16_t MAX_SH_SIGNALS = shSignalCountFromOrder(MAX_SH_ORDER);
 static_assert(std::atomic<NormalizationType>::is_always_lock_free);
 static_assert(std::atomic<uint8_t>::is_always_lock_free);
 
+/// @brief Everything the SH weights and the gain applied by the encoder
+/// depend on.
+struct EncodingParams
+{
+    DirectionWithDistance source{};
+    uint8_t sh_order{0};
+    NormalizationType normalization{NormalizationType::DEFAULT};
+    DistanceAttenuationType dist_att_type{DistanceAttenuationType::DEFAULT};
+    float dist_att_max_distance{0};
+
+    bool operator==(const EncodingParams&) const = default;
+};
+
 /**
  * @brief Basic encoder performing ambisonic panning and distance-based gain
  * attenuation.
@@ -71,6 +84,29 @@ class BasicEncoder : public juce::ValueTree::Listener
     float _prev_weights[MAX_SH_SIGNALS];
     float _prev_gain{0};
 
+    /// @brief params `_curr_weights` and `_curr_gain` were calculated for,
+    /// std::nullopt before the first `process` call.
+    std::optional<EncodingParams> _curr_params{};
+    float _curr_weights[MAX_SH_SIGNALS];
+    float _curr_gain{0};
+
+    /**
+     * @brief Recalculates `_curr_weights` and `_curr_gain` if `params` differ
+     * from the ones they were last calculated for, so static sources don't
+     * pay for getRSH on every block.
+     *
+     * @return true if the weights and gain were recalculated.
+     */
+    bool updateWeightsAndGain(const EncodingParams& params);
+
+    /**
+     * @brief Encodes the buffer with the current weights and gain, without
+     * interpolating from the previous ones. Only valid if they didn't
+     * change since the previous `process` call.
+     */
+    void processSteadyState(utils::audio::BufferView<float> buffer,
+                            uint16_t num_sh_signals);
+
     /**
      * @brief Calculates interpolator buffers for given frame size
      * Basically fills interpolator buffers with `frame_size` values
@@ -1,6 +1,11 @@
 #pragma once
 #include "Events.h"
 
+#include "EventSlot.h"
+
+#include <LockFree/MPSCQueue.h>
+#include <Utility/Utils.h>
+
 namespace ambilink::events {
 
 template<typename T>
@@ -24,49 +29,64 @@ public:
     virtual void onEvent(EventBase& event) = 0;
 };
 
+template<typename EventTypeList>
+class AsyncEventConsumer;
+
 /**
  * @brief An EventConsumer implementation that can be used to delay
  * event processing or offload it to a separate thread.
+ *
+ * Events are copied by value into fixed-size slots, so sending and consuming
+ * events never allocates.
+ *
+ * @tparam EventTypes the events that will be queued, all other events are
+ * ignored.
  */
-class AsyncEventConsumer : public EventConsumer
+template<IsConcreteEvent... EventTypes>
+class AsyncEventConsumer<utils::TypeList<EventTypes...>> : public EventConsumer
 {
-    lock_free::Queue<std::unique_ptr<EventBase>, 500> _event_queue{};
+    using Slot = EventSlot<EventTypes...>;
+
+    /// @brief events may be sent from multiple threads (GUI, host threads).
+    lock_free::MPSCQueue<Slot, 512> _event_queue{};
 
     /**
      * @brief Override in derived class to be informed when an event
-     * becomes available.
+     * becomes available. Called on the thread that sent the event, after the
+     * event has been queued.
      */
     virtual void onEventAvailable() {}
-    /**
-     * @brief Default implementaion always returns true. Override to provide custom behaviour.
-     */
-    virtual bool wantsEvent(events::EventID);
 
 public:
-    struct NoQueuedEventError : public std::runtime_error
-    {
-        NoQueuedEventError() : std::runtime_error("No events to process"){};
-    };
-
-    virtual ~AsyncEventConsumer() = default;    
+    virtual ~AsyncEventConsumer() = default;
     AsyncEventConsumer() = default;
 
     /**
-     * @brief Adds an event to the internal queue. Called by the event
-     * source/propagator.
+     * @brief Adds an event to the internal queue if it's one of
+     * `EventTypes`. Called by the event source/propagator.
      *
      * @param event the event.
      */
-    void onEvent(EventBase& event) final;
+    void onEvent(EventBase& event) final {
+        if (!Slot::canHold(event.getEventTypeID())) return;
+
+        Slot slot{};
+        slot.emplaceCopy(event);
+        event.handled = _event_queue.pushOrFail(std::move(slot));
+        onEventAvailable();
+    }
 
     /**
-     * @brief Get the latest event from the queue.
-     * @throws NoQueuedEventError if the event queue is empty.
+     * @brief Processes up to `max_count` queued events in order, passing each
+     * to `handler`. Must only be called from the consuming thread.
      *
-     * @return std::unique_ptr<EventBase> the first unprocessed event
-     * in queue.
+     * @return the number of processed events.
      */
-    std::unique_ptr<EventBase> getEvent();
+    template<typename HandlerFunc>
+    size_t drainEvents(HandlerFunc&& handler, size_t max_count) {
+        return _event_queue.drain(
+          [&handler](Slot&& slot) { handler(slot.get()); }, max_count);
+    }
 
     /**
      * @brief Check if 1/more events are queued for processing.
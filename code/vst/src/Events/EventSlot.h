@@ -0,0 +1,100 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "Events.h"
+
+namespace ambilink::events {
+
+/**
+ * @brief Holds a copy of an event of one of `EventTypes` by value, in a buffer
+ * sized to fit the largest of them, so queueing events doesn't allocate.
+ *
+ * @tparam EventTypes the event types the slot can hold.
+ */
+template<IsConcreteEvent... EventTypes>
+class EventSlot
+{
+    constexpr static size_t storage_size = std::max({sizeof(EventTypes)...});
+    constexpr static size_t storage_align
+      = std::max({alignof(EventTypes)...});
+
+    alignas(storage_align) std::byte _storage[storage_size];
+    /// @brief points into `_storage` if the slot holds an event.
+    EventBase* _event{nullptr};
+
+    /**
+     * @brief Calls `func` with `event` cast to its concrete type.
+     *
+     * @return false if the event isn't one of `EventTypes`.
+     */
+    template<typename EventRefT, typename FuncT>
+    static bool visit(EventRefT&& event, FuncT&& func) {
+        constexpr bool is_const
+          = std::is_const_v<std::remove_reference_t<EventRefT>>;
+        const auto id = event.getEventTypeID();
+        return (
+          (id == EventTypes::id
+           && (func(static_cast<std::conditional_t<is_const, const EventTypes,
+                                                   EventTypes>&>(event)),
+               true))
+          || ...);
+    }
+
+    void reset() {
+        if (!_event) return;
+        _event->~EventBase();
+        _event = nullptr;
+    }
+
+    void moveFrom(EventSlot&& other) {
+        if (!other._event) return;
+        visit(*other._event, [this]<typename EventT>(EventT& event) {
+            _event = new (_storage) EventT(std::move(event));
+        });
+        other.reset();
+    }
+
+public:
+    EventSlot() = default;
+    ~EventSlot() { reset(); }
+
+    EventSlot(const EventSlot&) = delete;
+    EventSlot& operator=(const EventSlot&) = delete;
+
+    EventSlot(EventSlot&& other) noexcept { moveFrom(std::move(other)); }
+    EventSlot& operator=(EventSlot&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(std::move(other));
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Copies `event` into the slot, replacing the previously held
+     * event.
+     *
+     * @return false if the event isn't one of `EventTypes`, the slot is
+     * empty in that case.
+     */
+    bool emplaceCopy(const EventBase& event) {
+        reset();
+        return visit(event, [this]<typename EventT>(const EventT& concrete) {
+            _event = new (_storage) EventT(concrete);
+        });
+    }
+
+    /// @brief Checks if the slot is able to hold events with the given ID.
+    static bool canHold(EventID id) { return ((id == EventTypes::id) || ...); }
+
+    bool hasEvent() const { return _event != nullptr; }
+
+    /// @brief the held event, slot must not be empty.
+    EventBase& get() { return *_event; }
+};
+
+} // namespace ambilink::events
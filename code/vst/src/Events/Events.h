@@ -8,7 +8,6 @@
 #include <functional>
 #include <concepts>
 
-#include <LockFree/Queue.h>
 #include <Utility/IdGenerator.h>
 
 namespace ambilink::events {
@@ -6,6 +6,7 @@
 
 #include <IPC/Utils.h>
 #include <IPC/Commands.h>
+#include <IPC/Protocol.h>
 #include <IPC/States/Disconnected.h>
 
 namespace ambilink::gui {
@@ -23,9 +24,8 @@ ObjectSelectionScreen::ObjectSelectionScreen(
     initTopPanel();
     addAndMakeVisible(_top_panel);
 
-    updateFromState();
     _other_plugin_state.addListener(this);
-    sendEvent(ipc::commands::UpdateObjectList{});
+    resetPages();
 };
 
 ObjectSelectionScreen::~ObjectSelectionScreen() {
@@ -34,6 +34,7 @@ ObjectSelectionScreen::~ObjectSelectionScreen() {
 
 void ObjectSelectionScreen::initTopPanel() {
     _search_field->addListener(this);
+    _search_field->setInputRestrictions(max_search_string_length);
     _search_field->setJustification(juce::Justification::centredLeft);
     _search_field->setTextToShowWhenEmpty("Type here to search objects",
                                           colors::panel::component::hint_text);
@@ -53,67 +54,95 @@ void ObjectSelectionScreen::resized() {
 
 void ObjectSelectionScreen::visibilityChanged() {
     if (isShowing()) {
-        sendEvent(ipc::commands::UpdateObjectList{});
+        resetPages();
         _search_field->grabKeyboardFocus();
         startTimerHz(update_interval_hz);
     } else {
         _search_field->clear();
         stopTimer();
-        updateShownObjects();
     }
 }
 
 void ObjectSelectionScreen::timerCallback() {
-    sendEvent(ipc::commands::UpdateObjectList{});
+    dropTimedOutPageRequests();
+    const auto first_visible_row
+      = std::max(_object_list.getRowContainingPosition(0, 0), 0);
+    const auto page_index = static_cast<uint32_t>(first_visible_row) / page_size;
+    // If the object list hasn't changed, the IPC Client won't report anything.
+    sendEvent(ipc::commands::QueryObjectList{_search_field->getText(),
+                                             page_index * page_size, page_size,
+                                             _object_list_version});
 }
 
 void ObjectSelectionScreen::valueTreePropertyChanged(
   juce::ValueTree&, const juce::Identifier& property) {
-    if (property == ids::object_list) {
-        updateFromState();
+    if (property == ids::object_list_page) {
+        onObjectListPageReceived();
     } else if (property == ids::ipc_client_state
                && !ipc::isInState<ipc::state::Disconnected>(
                  _other_plugin_state)) {
-        sendEvent(ipc::commands::UpdateObjectList{});
+        resetPages();
     }
 }
 
-void ObjectSelectionScreen::updateFromState() {
-    if (auto obj_list_value = _other_plugin_state[ids::object_list];
-        !obj_list_value.isVoid()) {
-        _all_objects.clearQuick();
-        _all_objects = *_other_plugin_state[ids::object_list].getArray();
-    } else {
-        _all_objects = {};
-    }
-    updateShownObjects();
+void ObjectSelectionScreen::requestPage(uint32_t page_index) {
+    const auto [_, inserted] = _pending_pages.try_emplace(
+      page_index, juce::Time::getMillisecondCounter());
+    if (!inserted) return;
+    sendEvent(ipc::commands::QueryObjectList{_search_field->getText(),
+                                             page_index * page_size, page_size});
 }
 
-void ObjectSelectionScreen::updateShownObjects() {
-    _shown_objects.clear();
-    if (_search_field->isEmpty()) {
-        std::for_each(_all_objects.begin(), _all_objects.end(),
-                      [this](const auto& object_name) {
-                          _shown_objects.emplace_back(object_name);
-                      });
-    } else {
-        auto search_string = _search_field->getText().toLowerCase();
-        std::map<int, std::vector<juce::StringRef>> tmp{};
-        for (const auto& object_name : _all_objects) {
-            auto index = object_name.toLowerCase().indexOf(search_string);
-            if (index == -1) continue;
-            tmp[index].emplace_back(object_name);
-        }
-        for (auto&& [_, items] : tmp) {
-            for (auto&& item : items) {
-                _shown_objects.emplace_back(item);
-            }
-        }
+void ObjectSelectionScreen::dropTimedOutPageRequests() {
+    const auto now = juce::Time::getMillisecondCounter();
+    const auto dropped
+      = std::erase_if(_pending_pages, [now](const auto& page_request) {
+            return now - page_request.second >= pending_page_timeout_ms;
+        });
+    // Visible rows of the dropped pages request them again when repainted.
+    if (dropped > 0) _object_list.repaint();
+}
+
+void ObjectSelectionScreen::resetPages() {
+    _pages.clear();
+    _pending_pages.clear();
+    _object_list_version = 0;
+    _total_objects = 0;
+    _object_list.updateContent();
+    requestPage(0);
+}
+
+void ObjectSelectionScreen::onObjectListPageReceived() {
+    auto* page = dynamic_cast<ipc::ObjectListPage*>(
+      _other_plugin_state[ids::object_list_page].getObject());
+    // Ignore replies to queries for a previous search string.
+    if (!page || page->query != _search_field->getText()) return;
+
+    if (page->version != _object_list_version) {
+        _pages.clear();
+        _object_list_version = page->version;
     }
+
+    const auto page_index = page->offset / page_size;
+    _pages[page_index] = page->names;
+    _pending_pages.erase(page_index);
+    _total_objects = static_cast<int>(page->total_count);
+
     _object_list.updateContent();
+    _object_list.repaint();
+}
+
+std::optional<juce::String> ObjectSelectionScreen::getObjectName(int row) const {
+    if (row < 0 || row >= _total_objects) return std::nullopt;
+    const auto page_it = _pages.find(static_cast<uint32_t>(row) / page_size);
+    if (page_it == _pages.end()) return std::nullopt;
+
+    const auto index_in_page = static_cast<int>(row % page_size);
+    if (index_in_page >= page_it->second.size()) return std::nullopt;
+    return page_it->second[index_in_page];
 }
 
-int ObjectSelectionScreen::getNumRows() { return _shown_objects.size(); }
+int ObjectSelectionScreen::getNumRows() { return _total_objects; }
 
 void ObjectSelectionScreen::paintListBoxItem(int row_number, juce::Graphics& g,
                                              int width, int height,
@@ -129,14 +158,23 @@ void ObjectSelectionScreen::paintListBoxItem(int row_number, juce::Graphics& g,
         g.setColour(colors::white);
     }
 
+    const auto object_name = getObjectName(row_number);
+    if (!object_name) {
+        // Pages are fetched lazily, as rows become visible.
+        requestPage(static_cast<uint32_t>(row_number) / page_size);
+        return;
+    }
+
     g.setFont(font_height);
-    g.drawText(_shown_objects[static_cast<size_t>(row_number)], 5, 0, width,
-               height, juce::Justification::centredLeft, true);
+    g.drawText(*object_name, 5, 0, width, height,
+               juce::Justification::centredLeft, true);
 }
 
 void ObjectSelectionScreen::onSelect(int selected_item) {
-    sendEvent(ipc::commands::SubscribeToObject{
-      _shown_objects[static_cast<size_t>(selected_item)]});
+    const auto object_name = getObjectName(selected_item);
+    if (!object_name) return;
+
+    sendEvent(ipc::commands::SubscribeToObject{*object_name});
     _object_list.updateContent();
     _object_list.setSelectedRows({}, juce::dontSendNotification);
     _other_plugin_state.setProperty(ids::object_name, "...", nullptr);
@@ -148,11 +186,11 @@ void ObjectSelectionScreen::selectedRowsChanged(int lastRowselected) {
 }
 
 void ObjectSelectionScreen::textEditorTextChanged(juce::TextEditor&) {
-    updateShownObjects();
+    resetPages();
 }
 
 void ObjectSelectionScreen::textEditorReturnKeyPressed(juce::TextEditor&) {
-    if (!_search_field->isEmpty() && !_shown_objects.empty())
+    if (!_search_field->isEmpty())
         onSelect(0); // If enter pressed when searching, the first
                      // item is selected
 }
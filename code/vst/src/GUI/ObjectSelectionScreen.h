@@ -2,6 +2,9 @@
 #include "Screen.h"
 #include "Components/TopPanel.h"
 
+#include <map>
+#include <optional>
+
 namespace ambilink::gui {
 
 /**
@@ -19,6 +22,10 @@ class ObjectSelectionScreen : public Screen<ObjectSelectionScreen>,
     constexpr static uint8_t update_interval_hz = 3;
     constexpr static uint8_t object_list_row_height = 22;
     constexpr static uint8_t font_height = object_list_row_height * 0.7;
+    /// @brief number of object names requested from the Blender add-on at once.
+    constexpr static uint32_t page_size = 50;
+    /// @brief Blender limits object names to 63 characters.
+    constexpr static int max_search_string_length = 63;
 
     juce::ListBox _object_list;
     /// @brief contains the search field.
@@ -26,10 +33,30 @@ class ObjectSelectionScreen : public Screen<ObjectSelectionScreen>,
     std::shared_ptr<juce::TextEditor> _search_field
       = std::make_shared<juce::TextEditor>();
 
-    juce::StringArray _all_objects;
-    std::vector<juce::StringRef> _shown_objects;
-
-    void updateShownObjects();
+    /// @brief number of objects matching the current search string.
+    int _total_objects{0};
+    /// @brief version of the object list the cached pages were taken from.
+    uint64_t _object_list_version{0};
+    /// @brief cached pages of names matching the current search string.
+    std::map<uint32_t, juce::StringArray> _pages{};
+    /// @brief pages that have been requested but not received yet, mapped to
+    /// the time of the request (juce::Time::getMillisecondCounter()).
+    std::map<uint32_t, juce::uint32> _pending_pages{};
+    /// @brief requests without a reply after this long are dropped, so the
+    /// page is requested again when painted (e.g. if the IPC Client wasn't
+    /// connected).
+    constexpr static juce::uint32 pending_page_timeout_ms = 2000;
+    /// @brief drops timed out requests from `_pending_pages`.
+    void dropTimedOutPageRequests();
+
+    /// @brief requests a page of objects matching the current search string.
+    void requestPage(uint32_t page_index);
+    /// @brief drops all cached pages and requests the first one.
+    void resetPages();
+    /// @brief caches the page stored in the ids::object_list_page prop.
+    void onObjectListPageReceived();
+    /// @brief returns the name shown in `row`, if its page has been received.
+    std::optional<juce::String> getObjectName(int row) const;
 
     int getNumRows() override;
     void paintListBoxItem(int rowNumber, juce::Graphics& g, int width,
@@ -44,7 +71,6 @@ class ObjectSelectionScreen : public Screen<ObjectSelectionScreen>,
     void textEditorReturnKeyPressed(juce::TextEditor&) final;
     void textEditorEscapeKeyPressed(juce::TextEditor&) final;
 
-    void updateFromState();
     void visibilityChanged() final;
 
     bool keyPressed(const juce::KeyPress& key) final;
@@ -52,7 +78,7 @@ class ObjectSelectionScreen : public Screen<ObjectSelectionScreen>,
     /// @brief populates the top panel and sets the layout.
     void initTopPanel();
 
-    /// @brief sends a request to update objectList to the IPC Client.
+    /// @brief asks the IPC Client whether the visible page has changed.
     void timerCallback() final;
 
 public:
@@ -28,11 +28,17 @@ SettingsScreen::SettingsScreen(juce::AudioProcessorValueTreeState& params,
     _ambi_order_slider_attachment = std::make_unique<SliderAttachment>(
       _params, ids::params::ambisonics_order.toString(), _ambi_order_input);
 
+    _world_oriented_toggle.setLabelText("World Oriented (Ambilink Listener)");
+    _world_oriented_toggle.component.getToggleStateValue().referTo(
+      _other_plugin_state.getPropertyAsValue(ids::world_oriented_encoding,
+                                             nullptr));
+
     initTopPanel();
 
     addAndMakeVisible(_top_panel);
     addAndMakeVisible(_norm_type_picker);
     addAndMakeVisible(_ambi_order_input);
+    addAndMakeVisible(_world_oriented_toggle);
 };
 
 void SettingsScreen::initTopPanel() {
@@ -43,7 +49,7 @@ void SettingsScreen::initTopPanel() {
 void SettingsScreen::resized() {
     MainContentParameterLayout{}.layout(
       getLocalBounds(), _top_panel, _norm_type_picker,
-      _ambi_order_input);
+      _ambi_order_input, _world_oriented_toggle);
 };
 
 } // namespace ambilink::gui
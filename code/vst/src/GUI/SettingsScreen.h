@@ -8,7 +8,8 @@
 namespace ambilink::gui {
 
 /**
- * @brief The settings screen, currently includes the ambisonics settings.
+ * @brief The settings screen, currently includes the ambisonics settings and
+ * the world oriented encoding toggle.
  * 
  */
 class SettingsScreen : public Screen<SettingsScreen>
@@ -21,6 +22,8 @@ class SettingsScreen : public Screen<SettingsScreen>
     // GUI components controlling the audio parameters
     components::LabeledComponent<juce::ComboBox> _norm_type_picker;
     components::LabeledComponent<juce::Slider> _ambi_order_input{};
+    /// @brief bound to the `world_oriented_encoding` property.
+    components::LabeledComponent<juce::ToggleButton> _world_oriented_toggle{};
 
     // attachments used to connect GUI components to audio parameters
     std::unique_ptr<ComboBoxAttachment> _norm_type_combo_attachment{};
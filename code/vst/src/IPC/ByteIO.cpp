@@ -1,15 +1,19 @@
 #include "ByteIO.h"
+#include "MessagePool.h"
+
+#include <nngpp/error.h>
 
 namespace {
-auto spanFromNngBuffer(nng::buffer&& buffer) {
-    auto size = buffer.size();
-    return std::span<uint8_t>{static_cast<uint8_t*>(buffer.release()), size};
+auto spanFromNngMsg(const nng::msg& msg) {
+    return std::span<uint8_t>{static_cast<uint8_t*>(nng_msg_body(msg.get())),
+                              nng_msg_len(msg.get())};
 }
 } // namespace
 namespace ambilink::ipc {
-DataReader::DataReader(nng::buffer&& data) : _data{spanFromNngBuffer(std::move(data))} {}
+DataReader::DataReader(nng::msg&& msg)
+  : _msg{std::move(msg)}, _data{spanFromNngMsg(_msg)} {}
 
-DataReader::~DataReader() { nng_free(_data.data(), _data.size()); }
+DataReader::~DataReader() { MessagePool::release(std::move(_msg)); }
 
 std::span<uint8_t> DataReader::readBytes(size_t count) {
     if (count > remaining())
@@ -19,26 +23,21 @@ std::span<uint8_t> DataReader::readBytes(size_t count) {
     return retval;
 }
 
-DataWriter::DataWriter(std::span<uint8_t> initial_data)
-  : _data{initial_data.begin(), initial_data.end()} {}
-DataWriter::DataWriter(std::vector<uint8_t> initial_data)
-  : _data{std::move(initial_data)} {}
-
-void DataWriter::write_bytes(const std::vector<uint8_t>& data) {
-    _data.insert(_data.end(), data.begin(), data.end());
-}
+DataWriter::DataWriter() : _msg{MessagePool::acquire()} {}
 
 void DataWriter::write_bytes(const uint8_t* data, size_t size) {
-    _data.insert(_data.end(), data, data + size);
+    // Only reallocates if the pooled message's capacity is exceeded.
+    if (auto err = nng_msg_append(_msg.get(), data, size))
+        throw nng::exception(err, "nng_msg_append");
 }
 
 void DataWriter::write_string(const std::u8string& string) {
-    _data.insert(_data.end(), string.begin(), string.end());
+    write_bytes(reinterpret_cast<const uint8_t*>(string.data()), string.size());
 }
 
 void DataWriter::write_string(const juce::String& string) {
-    _data.insert(_data.end(), string.toRawUTF8(),
-                 string.toRawUTF8() + string.getNumBytesAsUTF8());
+    write_bytes(reinterpret_cast<const uint8_t*>(string.toRawUTF8()),
+                string.getNumBytesAsUTF8());
 }
 
 } // namespace ambilink::ipc
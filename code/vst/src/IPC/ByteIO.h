@@ -1,31 +1,38 @@
 #pragma once
-#include <nngpp/buffer.h>
+#include <nngpp/msg.h>
+#include <cstring>
 #include <span>
 #include <stdexcept>
-#include <vector>
 #include <string>
+#include <type_traits>
 
 #include <juce_core/juce_core.h>
 
 namespace ambilink::ipc {
 
 /**
- * @brief Helper for reading IPC message data.
+ * @brief Helper for reading IPC message data. Reads directly from the body of
+ * the received message, which is returned to the MessagePool on destruction.
  */
 class DataReader
 {
+    nng::msg _msg;
     std::span<uint8_t> _data;
     size_t _read_pos = 0;
 
 public:
-    explicit DataReader(nng::buffer&& data);
-    DataReader(const DataReader& other) = default;
-    DataReader(DataReader&& other) = default;
-    DataReader& operator=(const DataReader& other) = default;
-    DataReader& operator=(DataReader&& other) = default;
+    explicit DataReader(nng::msg&& msg);
+    DataReader(const DataReader& other) = delete;
+    DataReader(DataReader&& other) noexcept = default;
+    DataReader& operator=(const DataReader& other) = delete;
+    DataReader& operator=(DataReader&& other) = delete;
 
     ~DataReader();
 
+    /**
+     * @brief Returns a view of the next `count` bytes of the message, valid for
+     * the lifetime of the reader.
+     */
     std::span<uint8_t> readBytes(size_t count);
 
     size_t remaining() { return _data.size() - _read_pos; }
@@ -35,9 +42,11 @@ public:
      */
     template<typename T>
     T read() {
+        static_assert(std::is_trivially_copyable_v<T>);
         if (sizeof(T) > remaining())
             throw std::out_of_range("data_reader_t: attempted read beyond bounds.");
-        T retval = *reinterpret_cast<const T*>(_data.data() + _read_pos);
+        T retval;
+        std::memcpy(&retval, _data.data() + _read_pos, sizeof(T));
         _read_pos += sizeof(T);
         return retval;
     }
@@ -57,45 +66,32 @@ public:
 };
 
 /**
- * @brief Helper for writing IPC message data.
+ * @brief Helper for writing IPC message data. Serialises directly into the
+ * body of a message acquired from the MessagePool.
  */
 class DataWriter
 {
-    std::vector<uint8_t> _data{};
+    nng::msg _msg;
 
 public:
-    DataWriter() = default;
-    explicit DataWriter(std::span<uint8_t> initial_data);
-    explicit DataWriter(std::vector<uint8_t> initial_data);
+    DataWriter();
 
     /**
-     * @brief Returns a copy of the currently written data.
-     *
-     * @return std::vector<uint8_t>
+     * @brief Moves the message out of the writer, ready to be sent. Only
+     * callable on an r-value. No copy is performed.
      */
-    std::vector<uint8_t> get_data() { return _data; }
+    nng::msg release_msg() && { return std::move(_msg); }
 
-    /**
-     * @brief Moves the written data from the internal store. Only callable on an r-value.
-     * No copy is performed.
-     *
-     * @return std::vector<uint8_t>
-     */
-    std::vector<uint8_t> release_data() && { return std::move(_data); }
+    size_t written() { return nng_msg_len(_msg.get()); }
 
-    size_t written() { return _data.size(); }
-    
     template<typename T>
     void write(T value) {
         // doesn't take endiannes into account because intended for IPC communication on
         // the same machine.
-
-        auto write_pos = _data.size();
-        _data.resize(_data.size() + sizeof(T));
-        memcpy(_data.data() + write_pos, &value, sizeof(T));
+        static_assert(std::is_trivially_copyable_v<T>);
+        write_bytes(reinterpret_cast<const uint8_t*>(&value), sizeof(T));
     }
 
-    void write_bytes(const std::vector<uint8_t>& data);
     void write_string(const std::u8string& string);
     void write_string(const juce::String& string);
     void write_bytes(const uint8_t* data, size_t size);
@@ -7,32 +7,50 @@
 #include <string>
 #include "States/Disconnected.h"
 #include "States/ErrorState.h"
+#include <Math/Math.h>
 #include <spdlog/spdlog.h>
 
 namespace ambilink::ipc {
 
+namespace {
+/// @brief (un)subscribes the sub socket from messages prefixed with `id`.
+void setTopicSubscription(nng::socket& pubsub_sock, AmbilinkID id,
+                          bool subscribed) {
+    pubsub_sock.set_opt(subscribed ? NNG_OPT_SUB_SUBSCRIBE
+                                   : NNG_OPT_SUB_UNSUBSCRIBE,
+                        nng::view{&id, sizeof(id)});
+}
+} // namespace
+
 IPCClient::IPCClient(juce::ValueTree& other_state)
   : _other_plugin_state(other_state), _reqrep_sock(nng::req::open()),
     _pubsub_sock(nng::sub::open()),
-    _sub_thread_ctrl(makeSubThreadController()) {
+    _sub_thread_ctrl(makeSubThreadController()),
+    _requestor_thread_ctrl{[this]() { wakeRequestorThread(); }} {
     _reqrep_sock.set_opt_ms(NNG_OPT_RECVTIMEO,
                             IPCClient::reqrep_recv_timeout.count());
     _reqrep_sock.set_opt_ms(NNG_OPT_SENDTIMEO,
                             IPCClient::reqrep_send_timeout.count());
     _pubsub_sock.set_opt_ms(NNG_OPT_RECVTIMEO,
                             IPCClient::pubsub_recv_timeout.count());
-    _pubsub_sock.set_opt(NNG_OPT_SUB_SUBSCRIBE, {});
+    // Messages for the subscribed object are subscribed to when the sub
+    // thread is started, so NNG drops messages about other objects.
+    setTopicSubscription(_pubsub_sock, constants::broadcast_ambilink_id, true);
 
     _current_state_id = static_cast<size_t>(state::Disconnected::id);
     _states[_current_state_id] = makeDisconnectedState();
     updateIPCStateValueTreeProp();
+    _other_plugin_state.addListener(this);
+    _heartbeat->addListener(_requestor_thread_ctrl.wake);
     _req_rep_thread = std::thread{[this]() { requestorThreadFunc(); }};
 }
 
 IPCClient::~IPCClient() {
     spdlog::debug("In IPCClient destructor.");
+    _other_plugin_state.removeListener(this);
+    _heartbeat->removeListener(_requestor_thread_ctrl.wake);
     _req_rep_thread_should_stop = true;
-    _req_rep_thread_cond_var.notify_one();
+    wakeRequestorThread();
     spdlog::debug("About to join reqrep thread.");
     _req_rep_thread.join();
 
@@ -67,6 +85,10 @@ state::SubThreadController IPCClient::makeSubThreadController() {
             _sub_thread_should_stop = true;
             _sub_thread.join();
         }
+        if (_obj_id != id) {
+            if (_obj_id) setTopicSubscription(_pubsub_sock, *_obj_id, false);
+            setTopicSubscription(_pubsub_sock, id, true);
+        }
         _obj_id = id;
         _sub_thread_should_stop = false;
         _sub_thread = std::thread([this]() { subscriberThreadFunc(); });
@@ -77,8 +99,57 @@ state::SubThreadController IPCClient::makeSubThreadController() {
 
 std::unique_ptr<state::Disconnected> IPCClient::makeDisconnectedState() {
     return std::make_unique<state::Disconnected>(
-      _reqrep_sock, _pubsub_sock, _current_direction, _current_distance,
-      _other_plugin_state, _sub_thread_ctrl);
+      _reqrep_sock, _pubsub_sock, _current_motion, _shared_position_slot,
+      _other_plugin_state, _sub_thread_ctrl, _requestor_thread_ctrl);
+}
+
+DirectionWithDistance IPCClient::getCurrentDirectionAndDistance_rt() {
+    const auto now_ns = math::motionClockNowNs();
+    const auto* slot = _shared_position_slot.load(std::memory_order_acquire);
+    if (slot != _last_read_slot) {
+        _last_read_slot = slot;
+        _last_read_slot_seq = 0;
+        _last_read_motion_version = 0;
+        _slot_motion_estimator.reset();
+        _extrapolation.setState({}, now_ns);
+    }
+
+    if (!slot) {
+        if (_current_motion.version() != _last_read_motion_version) {
+            const auto snapshot = _current_motion.read();
+            _last_read_motion_version = snapshot.version;
+            _extrapolation.setState(snapshot.value, now_ns);
+        }
+    } else if (auto sample = readSharedPositionSlot(*slot);
+               sample && sample->seq != _last_read_slot_seq) {
+        // Keeps the previous value if the slot is being written.
+        _last_read_slot_seq = sample->seq;
+        _extrapolation.setState(
+          _slot_motion_estimator.update(
+            sample->location, static_cast<int64_t>(sample->timestamp_ns)),
+          now_ns);
+    }
+
+    // Extrapolated to the current time to make up for the IPC latency.
+    const auto location = _extrapolation.locationAt(now_ns);
+    return location ? math::directionFromCamSpaceLocation(*location)
+                    : DirectionWithDistance{};
+}
+
+void IPCClient::wakeRequestorThread() {
+    _req_rep_thread_wake_requested = true;
+    // Taking the mutex orders the notification after the requestor's
+    // predicate check, so the wakeup can't be lost between the check and the
+    // wait.
+    { std::lock_guard guard{_req_rep_thread_cond_var_mu}; }
+    _req_rep_thread_cond_var.notify_one();
+}
+
+void IPCClient::valueTreePropertyChanged(juce::ValueTree&,
+                                         const juce::Identifier& property) {
+    if (property == ids::object_name
+        || property == ids::world_oriented_encoding)
+        wakeRequestorThread();
 }
 
 void IPCClient::transitionToErrorOrDisconnectedState() {
@@ -87,6 +158,8 @@ void IPCClient::transitionToErrorOrDisconnectedState() {
         std::rethrow_exception(exception);
     } catch (const nng::exception& e) {
         if (reconnectable_ipc_errors.contains(e.get_error())) {
+            // Let other instances verify their connections right away.
+            _heartbeat->onConnectionLost();
             setNextState(makeDisconnectedState());
             return;
         }
@@ -103,22 +176,30 @@ void IPCClient::transitionToErrorOrDisconnectedState() {
 void IPCClient::requestorThreadFunc() {
     while (!_req_rep_thread_should_stop) {
         try {
-            if (eventQueued()) {
-                auto command = getEvent();
-                jassert(command);
-                setNextState(
-                  getCurrentStateUnlocked().processCommand(*command, [this]() {
-                      return _req_rep_thread_should_stop.load();
-                  }));
-            }
+            drainEvents(
+              [this](events::EventBase& command) {
+                  setNextState(getCurrentStateUnlocked().processCommand(
+                    command,
+                    [this]() { return _req_rep_thread_should_stop.load(); }));
+              },
+              max_events_per_iteration);
             setNextState(getCurrentStateUnlocked().reqRepThreadIdleUpdate(
               [this]() { return _req_rep_thread_should_stop.load(); }));
             getCurrentStateUnlocked().sendPingRequest();
 
-            if (eventQueued()) continue;
+            const auto wakeup_time
+              = getCurrentStateUnlocked().nextWakeupTime();
+            auto should_wake = [this]() {
+                return _req_rep_thread_wake_requested.exchange(false)
+                       || eventQueued() || _req_rep_thread_should_stop;
+            };
             std::unique_lock lock{_req_rep_thread_cond_var_mu};
-            _req_rep_thread_cond_var.wait_for(lock,
-                                              std::chrono::milliseconds(50));
+            if (wakeup_time) {
+                _req_rep_thread_cond_var.wait_until(lock, *wakeup_time,
+                                                    should_wake);
+            } else {
+                _req_rep_thread_cond_var.wait(lock, should_wake);
+            }
         } catch (...) {
             transitionToErrorOrDisconnectedState();
         }
@@ -129,13 +210,20 @@ void IPCClient::requestorThreadFunc() {
 void IPCClient::subscriberThreadFunc() {
     while (!_sub_thread_should_stop) {
         try {
-            auto msg_data_reader = DataReader{_pubsub_sock.recv()};
+            auto msg_data_reader = DataReader{_pubsub_sock.recv_msg()};
             assert(_obj_id.has_value());
-            if (*_obj_id != msg_data_reader.read<AmbilinkID>()) continue;
+            const auto id = msg_data_reader.read<AmbilinkID>();
+            if (id != *_obj_id && id != constants::broadcast_ambilink_id)
+                continue;
 
             using MsgType = constants::PubSubMsgType;
 
             auto msg_type = msg_data_reader.read<MsgType>();
+            // States get snapshots positioned at their object's location.
+            if ((msg_type == MsgType::FRAME_SNAPSHOT
+                 || msg_type == MsgType::WORLD_SNAPSHOT)
+                && !seekToSnapshotEntry(msg_data_reader, *_obj_id))
+                continue;
             getCurrentStateUnlocked().onPubSubCommand(msg_type,
                                                       msg_data_reader);
         } catch (const nng::exception& err) {
@@ -170,6 +258,8 @@ void IPCClient::setNextState(std::unique_ptr<state::StateBase>&& next_state) {
 
     spdlog::debug("State transition successful.");
     triggerAsyncUpdate();
+    // The new state gets its first idle update right away.
+    wakeRequestorThread();
 }
 
 StateBase& IPCClient::getCurrentStateUnlocked() {
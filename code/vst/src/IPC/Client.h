@@ -16,10 +16,16 @@
 
 #include <DataTypes.h>
 #include <Events/Consumers.h>
+#include <LockFree/SeqLock.h>
+#include <Math/DeadReckoning.h>
 
 #include "ByteIO.h"
+#include "Commands.h"
 #include "Constants.h"
 #include "Exceptions.h"
+#include "Heartbeat.h"
+#include "SharedPositions.h"
+#include "TrajectoryCache.h"
 
 #include "States/State.h"
 
@@ -30,8 +36,6 @@
 namespace ambilink::ipc {
 
 static_assert(std::atomic<bool>::is_always_lock_free);
-static_assert(std::atomic<Direction>::is_always_lock_free);
-static_assert(std::atomic<Distance>::is_always_lock_free);
 
 using StateBase = state::StateBase;
 using StateID = state::StateID;
@@ -42,11 +46,17 @@ using ScopedStateAccess = state::ScopedStateAccess<StateT>;
 /**
  * @brief Handles all IPC communication with the Blender plugin.
  */
-class IPCClient : public events::AsyncEventConsumer, public juce::AsyncUpdater
+class IPCClient : public events::AsyncEventConsumer<commands::AllCommands>,
+                  public juce::AsyncUpdater,
+                  private juce::ValueTree::Listener
 {
     constexpr static std::chrono::milliseconds reqrep_recv_timeout{10000};
     constexpr static std::chrono::milliseconds reqrep_send_timeout{500};
     constexpr static std::chrono::milliseconds pubsub_recv_timeout{0};
+    /// @brief max events processed by the reqrep thread before it does its
+    /// idle update and ping. The thread has no fixed polling interval, it
+    /// sleeps until woken or until the current state's next wakeup time.
+    constexpr static size_t max_events_per_iteration = 16;
 
     /// @brief nng errors that result from connection loss
     inline static const std::set<nng::error> reconnectable_ipc_errors{
@@ -66,17 +76,52 @@ class IPCClient : public events::AsyncEventConsumer, public juce::AsyncUpdater
     std::optional<AmbilinkID> _obj_id{};
 
     std::atomic<bool> _req_rep_thread_should_stop{false};
+    /// @brief set by wakeRequestorThread, consumed by the reqrep thread.
+    std::atomic<bool> _req_rep_thread_wake_requested{false};
     std::mutex _req_rep_thread_cond_var_mu{};
     std::condition_variable _req_rep_thread_cond_var{};
     std::thread _req_rep_thread{};
 
-    std::atomic<Direction> _current_direction{};
-    std::atomic<Distance> _current_distance{};
+    /// @brief location and velocity estimate from locations received via
+    /// Pub/Sub.
+    lock_free::SeqLock<math::MotionState> _current_motion{};
     state::SubThreadController _sub_thread_ctrl;
+    state::RequestorThreadController _requestor_thread_ctrl;
+    /// @brief wakes `_requestor_thread_ctrl` when another instance loses
+    /// the connection.
+    juce::SharedResourcePointer<Heartbeat> _heartbeat{};
+
+    /// @brief keeps the shared position segment mapped while the client
+    /// exists.
+    juce::SharedResourcePointer<SharedPositionSegment> _shared_positions{};
+    /// @brief keeps rendering data cached between renders while the client
+    /// exists.
+    juce::SharedResourcePointer<TrajectoryCache> _trajectory_cache{};
+    std::atomic<const SharedPositionSlot*> _shared_position_slot{nullptr};
+    static_assert(
+      std::atomic<const SharedPositionSlot*>::is_always_lock_free);
+
+    // Only accessed from the real-time thread.
+    const SharedPositionSlot* _last_read_slot{nullptr};
+    uint32_t _last_read_slot_seq{0};
+    /// @brief estimates velocities of shared memory samples.
+    math::MotionEstimator _slot_motion_estimator{};
+    /// @brief version of `_current_motion` last passed to `_extrapolation`,
+    /// 0 forces a read.
+    uint32_t _last_read_motion_version{0};
+    math::SmoothedExtrapolation _extrapolation{};
 
     /// @brief implementation of AsyncEventConsumer method informing reqrep
     /// thread of new event
-    void onEventAvailable() final { _req_rep_thread_cond_var.notify_one(); }
+    void onEventAvailable() final { wakeRequestorThread(); }
+    /// @brief wakes the reqrep thread if it's waiting for events.
+    void wakeRequestorThread();
+
+    /// @brief wakes the reqrep thread when the subscribed object is restored
+    /// from saved plugin state, or the world oriented encoding setting
+    /// changes.
+    void valueTreePropertyChanged(juce::ValueTree&,
+                                  const juce::Identifier& property) final;
 
     /// @brief thread func for thread handling Req/Rep communication
     void requestorThreadFunc();
@@ -121,17 +166,12 @@ public:
     }
 
     /**
-     * @brief If subscribed, returns the last direction received from the
-     * Blender plugin, if not, returns Direction{0,0}. Suitable for real-time
-     * thread usage.
-     */
-    Direction getCurrentDirection_rt() { return _current_direction; }
-    /**
-     * @brief If subscribed, returns the last distance received from the
-     * Blender plugin, if not, returns 0. Suitable for real-time
-     * thread usage.
+     * @brief If subscribed, returns the last direction and distance received
+     * from the Blender plugin (via shared memory if available), if not,
+     * returns Direction{0,0} and Distance{0}. Must only be called from the
+     * real-time thread.
      */
-    Distance getCurrentDistance_rt() { return _current_distance; }
+    DirectionWithDistance getCurrentDirectionAndDistance_rt();
 
     /**
      * @brief If IPC is in state StateT, returns a state::ScopedStateAccess<StateT>,
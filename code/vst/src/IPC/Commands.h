@@ -1,5 +1,6 @@
 #pragma once
 #include "../Events/Events.h"
+#include <Utility/Utils.h>
 
 #include <juce_core/juce_core.h>
 #include <glm/vec3.hpp>
@@ -19,13 +20,37 @@ struct Connect : events::Event<Connect>
 struct Unsubscribe : events::Event<Unsubscribe>
 {};
 
-struct UpdateObjectList : public events::Event<UpdateObjectList>
-{};
+/// @brief Requests a page of the names of objects matching a search query.
+struct QueryObjectList : public events::Event<QueryObjectList>
+{
+    /// @brief case-insensitive substring, empty matches all objects.
+    juce::String query;
+    uint32_t offset;
+    uint32_t limit;
+    /// @brief version of the object list the sender already has, 0 if none.
+    /// If still current, no page is sent back.
+    uint64_t known_version;
+    QueryObjectList(juce::String query_, uint32_t offset_, uint32_t limit_,
+                    uint64_t known_version_ = 0)
+      : query{std::move(query_)}, offset{offset_}, limit{limit_},
+        known_version{known_version_} {}
+};
 
 struct EnableRenderingMode : public events::Event<EnableRenderingMode>
-{};
+{
+    /// @brief position of the playhead when rendering starts, rendering data
+    /// is prefetched from there.
+    float start_time_secs;
+    EnableRenderingMode(float start_time_secs_ = 0)
+      : start_time_secs{start_time_secs_} {}
+};
 
 struct DisableRenderingMode : public events::Event<DisableRenderingMode>
 {};
 
+/// @brief all commands handled by IPCClient.
+using AllCommands
+  = utils::TypeList<SubscribeToObject, Connect, Unsubscribe, QueryObjectList,
+                    EnableRenderingMode, DisableRenderingMode>;
+
 } // namespace ambilink::ipc::commands
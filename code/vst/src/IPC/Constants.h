@@ -6,6 +6,55 @@ namespace ambilink::ipc::constants {
 // Not using std::string_view because of nngpp interface
 constexpr auto reqrep_addr = "ipc:///tmp/ambilink_reqrep";
 constexpr auto pubsub_addr = "ipc:///tmp/ambilink_pubsub";
+/// @brief name of the POSIX shared memory segment with object positions.
+constexpr auto shared_positions_name = "/ambilink_positions";
+
+/// @brief version of the protocol implemented by the plugin, sent with HELLO.
+/// Blender add-ons that don't support HELLO are treated as version 0.
+constexpr uint16_t protocol_version = 1;
+
+/// @brief optional protocol features, exchanged as a bitmask with HELLO.
+enum class Capability : uint32_t
+{
+    // 1 << 0 is reserved, it was used for the removed OBJ_LIST_DELTA command.
+    OBJ_LIST_QUERY = 1 << 1,
+    ENCODED_LOCATION_DATA = 1 << 2,
+    SHARED_MEMORY_POSITIONS = 1 << 3,
+    /// @brief GET_ANIMATION_INFO replies end with the animation revision.
+    ANIMATION_REVISION = 1 << 4,
+    /// @brief positions of all objects changed in a tick are published in
+    /// one FRAME_SNAPSHOT message.
+    FRAME_SNAPSHOT = 1 << 5,
+    /// @brief world space locations of moved objects and the camera's view
+    /// matrix are published instead of camera space locations.
+    WORLD_SPACE_POSITIONS = 1 << 6,
+    /// @brief CAMERA_SUB requests are supported.
+    CAMERA_SUB = 1 << 7,
+};
+
+/// @brief capabilities of the plugin, sent with HELLO.
+constexpr uint32_t client_capabilities
+  = static_cast<uint32_t>(Capability::OBJ_LIST_QUERY)
+    | static_cast<uint32_t>(Capability::ENCODED_LOCATION_DATA)
+    | static_cast<uint32_t>(Capability::SHARED_MEMORY_POSITIONS)
+    | static_cast<uint32_t>(Capability::ANIMATION_REVISION)
+    | static_cast<uint32_t>(Capability::FRAME_SNAPSHOT)
+    | static_cast<uint32_t>(Capability::WORLD_SPACE_POSITIONS);
+
+/// @brief optional flags byte appended to OBJ_SUB and OBJ_UNSUB requests.
+enum class SubFlags : uint8_t
+{
+    NONE = 0x00,
+    /// @brief positions are read from the shared memory segment, so they
+    /// don't need to be published for this subscriber.
+    SHARED_MEMORY_POSITIONS = 0x01,
+    /// @brief positions are received in FRAME_SNAPSHOT messages instead of
+    /// OBJECT_POSITION_UPDATED.
+    FRAME_SNAPSHOTS = 0x02,
+    /// @brief world space locations are received in WORLD_SNAPSHOT messages,
+    /// and transformed with the view matrix from CAMERA_MATRIX messages.
+    WORLD_SPACE_POSITIONS = 0x04,
+};
 
 enum class ReqRepCommand : uint8_t
 {
@@ -16,6 +65,13 @@ enum class ReqRepCommand : uint8_t
     INFORM_RENDER_FINISHED = 0x05,
     GET_RENDERING_LOCATION_DATA = 0x06,
     GET_ANIMATION_INFO = 0x07,
+    // 0x08 is reserved, it was used for the removed OBJ_LIST_DELTA command.
+    OBJ_LIST_QUERY = 0x09,
+    GET_RENDERING_LOCATION_DATA_ENCODED = 0x0A,
+    HELLO = 0x0B,
+    /// @brief subscribes to CAMERA_MATRIX messages for
+    /// `camera_sub_lease_duration`, used by the listener plugin.
+    CAMERA_SUB = 0x0C,
     PING = 0xFF,
 };
 
@@ -33,6 +89,33 @@ enum class PubSubMsgType : uint8_t
     OBJECT_POSITION_UPDATED = 0x00,
     OBJECT_RENAMED = 0x01,
     OBJECT_DELETED = 0x02,
+    /// @brief [2 bytes|count] [count * ([2 bytes|id] [3 floats|location])],
+    /// published with `broadcast_ambilink_id`.
+    FRAME_SNAPSHOT = 0x03,
+    /// @brief [16 floats|column-major view matrix], published with
+    /// `broadcast_ambilink_id` when the camera moves.
+    CAMERA_MATRIX = 0x04,
+    /// @brief same layout as FRAME_SNAPSHOT, with world space locations of
+    /// objects that moved.
+    WORLD_SNAPSHOT = 0x05,
+};
+
+/// @brief how long a CAMERA_SUB request keeps CAMERA_MATRIX messages
+/// published, in seconds.
+constexpr uint32_t camera_sub_lease_duration_secs = 15;
+
+/// @brief ambilink id prefix of pub/sub messages meant for all subscribers.
+constexpr uint16_t broadcast_ambilink_id = 0xFFFF;
+
+/// @brief encodings of GET_RENDERING_LOCATION_DATA_ENCODED replies.
+enum class LocationDataEncoding : uint8_t
+{
+    /// @brief 3 floats per frame, same as GET_RENDERING_LOCATION_DATA.
+    RAW_F32 = 0x00,
+    /// @brief per-axis float offset and scale, then the 16 bit quantized
+    /// coordinates of each frame, delta coded against the previous frame and
+    /// written as zigzag varints.
+    QUANTIZED_DELTA_U16 = 0x01,
 };
 
 } // namespace ambilink::ipc::constants
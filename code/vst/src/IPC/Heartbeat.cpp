@@ -0,0 +1,35 @@
+#include "Heartbeat.h"
+
+namespace ambilink::ipc {
+
+void Heartbeat::onContact() {
+    _last_contact.store(Clock::now().time_since_epoch().count(),
+                        std::memory_order_relaxed);
+}
+
+Heartbeat::Clock::time_point Heartbeat::getLastContactTime() const {
+    return Clock::time_point{
+      Clock::duration{_last_contact.load(std::memory_order_relaxed)}};
+}
+
+void Heartbeat::onConnectionLost() {
+    _connection_lost_count.fetch_add(1, std::memory_order_release);
+
+    std::lock_guard guard{_listeners_mu};
+    for (const auto* listener : _listeners) {
+        (*listener)();
+    }
+}
+
+void Heartbeat::addListener(const std::function<void()>& on_connection_lost) {
+    std::lock_guard guard{_listeners_mu};
+    _listeners.push_back(&on_connection_lost);
+}
+
+void Heartbeat::removeListener(
+  const std::function<void()>& on_connection_lost) {
+    std::lock_guard guard{_listeners_mu};
+    std::erase(_listeners, &on_connection_lost);
+}
+
+} // namespace ambilink::ipc
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace ambilink::ipc {
+
+/**
+ * @brief Process-wide connection health shared by all IPCClient instances.
+ * Use via juce::SharedResourcePointer.
+ *
+ * All instances talk to the same Blender add-on, so a successful reply to any
+ * instance proves the connection is alive for all of them. States only ping
+ * if nothing has been received by any instance for a ping interval, which
+ * results in roughly one ping per process instead of one per instance.
+ *
+ * When one instance loses the connection, all registered instances are woken
+ * so they can verify their own connection right away instead of waiting for
+ * their next ping.
+ */
+class Heartbeat
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::atomic<Clock::rep> _last_contact{0};
+    std::atomic<uint32_t> _connection_lost_count{0};
+    static_assert(std::atomic<Clock::rep>::is_always_lock_free);
+
+    std::mutex _listeners_mu{};
+    std::vector<const std::function<void()>*> _listeners{};
+
+public:
+    Heartbeat() = default;
+    Heartbeat(const Heartbeat&) = delete;
+    Heartbeat& operator=(const Heartbeat&) = delete;
+
+    /// @brief Records a successful reply from the Blender add-on.
+    void onContact();
+
+    /// @brief Time of the last successful reply received by any instance.
+    Clock::time_point getLastContactTime() const;
+
+    /**
+     * @brief Called by the instance which detected connection loss, wakes all
+     * registered instances.
+     */
+    void onConnectionLost();
+
+    /// @brief Incremented every time an instance loses the connection.
+    uint32_t getConnectionLostCount() const {
+        return _connection_lost_count.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Registers a callback invoked on connection loss. The callback
+     * must stay valid until removeListener is called.
+     */
+    void addListener(const std::function<void()>& on_connection_lost);
+    void removeListener(const std::function<void()>& on_connection_lost);
+};
+
+} // namespace ambilink::ipc
@@ -0,0 +1,40 @@
+#include "MessagePool.h"
+
+#include <vector>
+
+namespace ambilink::ipc {
+namespace {
+std::vector<nng::msg>& threadPool() {
+    thread_local std::vector<nng::msg> pool = [] {
+        std::vector<nng::msg> retval{};
+        retval.reserve(MessagePool::max_pooled_messages);
+        return retval;
+    }();
+    return pool;
+}
+} // namespace
+
+nng::msg MessagePool::acquire() {
+    auto& pool = threadPool();
+    if (pool.empty()) {
+        auto msg = nng::make_msg(initial_capacity);
+        // Keeps the allocated capacity.
+        nng_msg_clear(msg.get());
+        return msg;
+    }
+
+    auto msg = std::move(pool.back());
+    pool.pop_back();
+    nng_msg_clear(msg.get());
+    nng_msg_header_clear(msg.get());
+    return msg;
+}
+
+void MessagePool::release(nng::msg&& msg) noexcept {
+    if (!msg.get()) return;
+    auto& pool = threadPool();
+    if (pool.size() >= max_pooled_messages) return;
+    pool.emplace_back(std::move(msg));
+}
+
+} // namespace ambilink::ipc
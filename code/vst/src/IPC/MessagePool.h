@@ -0,0 +1,31 @@
+#pragma once
+#include <nngpp/msg.h>
+
+#include <cstddef>
+
+namespace ambilink::ipc {
+
+/**
+ * @brief Per-thread pool of nng messages.
+ *
+ * Replies are returned to the pool of the thread that read them once their
+ * DataReader is destroyed, and their bodies (with the capacity they already
+ * have) are reused for the next request written on that thread. This way
+ * steady-state req/rep traffic doesn't allocate message buffers on our side.
+ */
+class MessagePool
+{
+public:
+    /// @brief maximum number of idle messages kept per thread.
+    constexpr static size_t max_pooled_messages = 8;
+    /// @brief body capacity of messages allocated when the pool is empty.
+    constexpr static size_t initial_capacity = 256;
+
+    /// @brief returns an empty message, reusing a pooled one if available.
+    static nng::msg acquire();
+
+    /// @brief returns `msg` to the pool, or frees it if the pool is full.
+    static void release(nng::msg&& msg) noexcept;
+};
+
+} // namespace ambilink::ipc
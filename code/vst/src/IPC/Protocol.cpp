@@ -1,13 +1,15 @@
 #include "Protocol.h"
 #include "ByteIO.h"
 
+#include <Math/Math.h>
+
+#include <cstring>
+
 namespace ambilink::ipc {
-std::vector<uint8_t> encodeReqRepRequest(constants::ReqRepCommand command,
-                                         std::vector<uint8_t>&& data) {
+DataWriter makeReqRepRequest(constants::ReqRepCommand command) {
     DataWriter writer{};
     writer.write(command);
-    writer.write_bytes(std::move(data));
-    return std::move(writer).release_data();
+    return writer;
 }
 
 void checkReplyStatus(constants::ReqRepStatusCode status_code,
@@ -31,21 +33,14 @@ void checkReplyStatus(constants::ReqRepStatusCode status_code,
     }
 }
 
-std::vector<uint8_t> encodeObjectName(const std::u8string& name) {
-    if (name.size() > std::numeric_limits<uint8_t>::max())
+void writeObjectName(DataWriter& writer, const juce::String& name) {
+    const auto length = name.getNumBytesAsUTF8();
+    if (length > std::numeric_limits<uint8_t>::max())
         throw std::invalid_argument(
           "Blender object names may not be more than 63 characters long.");
-    DataWriter writer{};
 
-    auto length = name.size();
-    if (std::endian::native == std::endian::big) {
-        writer.write<uint8_t>(*(reinterpret_cast<uint8_t*>(&length)
-                                + (sizeof(decltype(length)) - 1)));
-    } else {
-        writer.write(*reinterpret_cast<uint8_t*>(&length));
-    }
+    writer.write(static_cast<uint8_t>(length));
     writer.write_string(name);
-    return std::move(writer).release_data();
 }
 
 juce::String decodeObjectName(DataReader& reader) {
@@ -63,4 +58,92 @@ juce::StringArray decodeObjectList(DataReader& reader) {
     return retval;
 }
 
+ObjectListPage::Ptr decodeObjectListPage(DataReader& reader,
+                                         juce::String query, uint32_t offset) {
+    const auto version = reader.read<uint64_t>();
+    if (const bool unchanged = reader.read<uint8_t>(); unchanged)
+        return nullptr;
+
+    ObjectListPage::Ptr page = new ObjectListPage{};
+    page->query = std::move(query);
+    page->offset = offset;
+    page->version = version;
+    page->total_count = reader.read<uint32_t>();
+
+    const auto count = reader.read<uint32_t>();
+    page->names.ensureStorageAllocated(static_cast<int>(count));
+    for (uint32_t i = 0; i < count; i++) {
+        page->names.add(decodeObjectName(reader));
+    }
+    return page;
+}
+
+namespace {
+void decodeQuantizedLocations(DataReader& reader, size_t frame_count,
+                              std::vector<DirectionWithDistance>& out) {
+    const auto offset = reader.read<glm::vec3>();
+    const auto scale = reader.read<glm::vec3>();
+
+    const auto bytes = reader.readBytes(reader.remaining());
+    size_t pos = 0;
+    auto readVarint = [&bytes, &pos]() {
+        uint32_t value = 0;
+        for (int shift = 0;; shift += 7) {
+            if (pos >= bytes.size() || shift > 14)
+                throw exceptions::ProtocolError(
+                  "Malformed quantized location data.");
+            const auto byte = bytes[pos++];
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+    };
+
+    glm::ivec3 quantized{0};
+    for (size_t frame = 0; frame < frame_count; frame++) {
+        for (int axis = 0; axis < 3; axis++) {
+            const auto zigzag = readVarint();
+            quantized[axis] += static_cast<int32_t>(zigzag >> 1)
+                               ^ -static_cast<int32_t>(zigzag & 1);
+        }
+        out.emplace_back(math::directionFromCamSpaceLocation(
+          offset + glm::vec3(quantized) * scale));
+    }
+}
+} // namespace
+
+void decodeRenderingLocationData(DataReader& reader,
+                                 constants::LocationDataEncoding encoding,
+                                 size_t frame_count,
+                                 std::vector<DirectionWithDistance>& out) {
+    using constants::LocationDataEncoding;
+    switch (encoding) {
+        case LocationDataEncoding::RAW_F32: {
+            auto bytes = reader.readBytes(frame_count * sizeof(glm::vec3));
+            for (size_t frame = 0; frame < frame_count; frame++) {
+                glm::vec3 location;
+                std::memcpy(&location, bytes.data() + frame * sizeof(glm::vec3),
+                            sizeof(glm::vec3));
+                out.emplace_back(math::directionFromCamSpaceLocation(location));
+            }
+            return;
+        }
+        case LocationDataEncoding::QUANTIZED_DELTA_U16:
+            decodeQuantizedLocations(reader, frame_count, out);
+            return;
+        default:
+            throw exceptions::ProtocolError(
+              "Unknown location data encoding: {:#04x}",
+              static_cast<uint8_t>(encoding));
+    }
+}
+
+bool seekToSnapshotEntry(DataReader& reader, AmbilinkID id) {
+    const auto count = reader.read<uint16_t>();
+    for (uint16_t i = 0; i < count; i++) {
+        if (reader.read<AmbilinkID>() == id) return true;
+        reader.discard<glm::vec3>();
+    }
+    return false;
+}
+
 } // namespace ambilink::ipc
@@ -6,49 +6,94 @@
 #include <vector>
 #include <juce_core/juce_core.h>
 
+#include <DataTypes.h>
+
 #include "Constants.h"
 #include "ByteIO.h"
 #include "Exceptions.h"
 
 namespace ambilink::ipc {
 
-/// @brief concats the command byte and the data
-std::vector<uint8_t> encodeReqRepRequest(constants::ReqRepCommand command,
-                                         std::vector<uint8_t>&& data);
-
-/// @brief returns a single-byte vector with the command byte
-inline std::vector<uint8_t>
-  encodeReqRepRequest(constants::ReqRepCommand command) {
-    return {static_cast<uint8_t>(command)};
-}
+/// @brief returns a writer with the command byte already written.
+DataWriter makeReqRepRequest(constants::ReqRepCommand command);
 
 /**
  * @brief Creates request data for given command, with command-specific data
- * given by an array of values of type T.
+ * given by a value of type T.
  */
 template<typename T>
-std::vector<uint8_t> encodeReqRepRequest(constants::ReqRepCommand command,
-                                         const T* data = nullptr,
-                                         size_t size = 0) {
-    DataWriter writer{};
-    writer.write(command);
-
-    // important check, because data and size are nullptr and 0, resp. by
-    // default.
-    if (!data || !size) return std::move(writer).release_data();
-
-    writer.write_bytes(reinterpret_cast<const uint8_t*>(data), size);
-    return std::move(writer).release_data();
+DataWriter makeReqRepRequest(constants::ReqRepCommand command, const T& data) {
+    auto writer = makeReqRepRequest(command);
+    writer.write(data);
+    return writer;
 }
 
-/// @brief encode an object name
-std::vector<uint8_t> encodeObjectName(const std::u8string& name);
+/// @brief write an object name
+void writeObjectName(DataWriter& writer, const juce::String& name);
 
 /// @brief decode an object name
 juce::String decodeObjectName(DataReader& reader);
 /// @brief decode a list of object names
 juce::StringArray decodeObjectList(DataReader& reader);
 
+/**
+ * @brief Protocol version and capabilities of the Blender add-on, as reported
+ * in the HELLO reply.
+ */
+struct ServerInfo
+{
+    uint16_t protocol_version{0};
+    uint32_t capabilities{0};
+
+    bool supports(constants::Capability capability) const {
+        return capabilities & static_cast<uint32_t>(capability);
+    }
+};
+
+/**
+ * @brief A page of the names of objects matching a search query. Reference
+ * counted so it can be passed to the GUI via a juce::var.
+ */
+struct ObjectListPage : public juce::ReferenceCountedObject
+{
+    using Ptr = juce::ReferenceCountedObjectPtr<ObjectListPage>;
+
+    juce::String query{};
+    uint32_t offset{0};
+    /// @brief version of the object list the page was taken from.
+    uint64_t version{0};
+    /// @brief number of objects matching the query.
+    uint32_t total_count{0};
+    juce::StringArray names{};
+};
+
+/**
+ * @brief decode an OBJ_LIST_QUERY reply (status byte already read).
+ *
+ * @return ObjectListPage::Ptr nullptr if the list is unchanged since the
+ * version sent with the request.
+ */
+ObjectListPage::Ptr decodeObjectListPage(DataReader& reader,
+                                         juce::String query, uint32_t offset);
+
+/**
+ * @brief decode `frame_count` camera space locations from a rendering location
+ * data reply, and append the corresponding directions and distances to `out`.
+ */
+void decodeRenderingLocationData(DataReader& reader,
+                                 constants::LocationDataEncoding encoding,
+                                 size_t frame_count,
+                                 std::vector<DirectionWithDistance>& out);
+
+/**
+ * @brief Moves the reader of a FRAME_SNAPSHOT or WORLD_SNAPSHOT message (type
+ * byte already read) to the location of object `id`, in a single pass over
+ * the (id, location) pairs.
+ *
+ * @return false if the snapshot doesn't contain the object.
+ */
+bool seekToSnapshotEntry(DataReader& reader, AmbilinkID id);
+
 /**
  * @brief Check the status code of a req/rep reply, throw on error statuses.
  *
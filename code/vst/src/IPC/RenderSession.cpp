@@ -0,0 +1,42 @@
+#include "RenderSession.h"
+
+#include "States/Common.h"
+
+namespace ambilink::ipc {
+
+AnimationInfo RenderSession::join(nng::socket_view reqrep_sock,
+                                  Heartbeat& heartbeat,
+                                  const ServerInfo& server_info) {
+    std::lock_guard guard{_mu};
+    if (!_animation_info) {
+        state::sendSimpleCommand(reqrep_sock, heartbeat,
+                                 constants::ReqRepCommand::PREPARE_TO_RENDER);
+        auto reply_data_reader = state::sendSimpleCommand(
+          reqrep_sock, heartbeat, constants::ReqRepCommand::GET_ANIMATION_INFO);
+
+        AnimationInfo animation_info{};
+        animation_info.frame_count = reply_data_reader.read<size_t>();
+        animation_info.fps = reply_data_reader.read<float>();
+        if (server_info.supports(constants::Capability::ANIMATION_REVISION))
+            animation_info.revision = reply_data_reader.read<uint64_t>();
+        _animation_info = animation_info;
+    }
+    _participant_count++;
+    return *_animation_info;
+}
+
+void RenderSession::leave(std::optional<nng::socket_view> reqrep_sock,
+                          Heartbeat& heartbeat) {
+    std::lock_guard guard{_mu};
+    jassert(_participant_count > 0);
+    if (_participant_count == 0 || --_participant_count > 0) return;
+
+    _animation_info.reset();
+    if (reqrep_sock) {
+        state::sendSimpleCommand(
+          *reqrep_sock, heartbeat,
+          constants::ReqRepCommand::INFORM_RENDER_FINISHED);
+    }
+}
+
+} // namespace ambilink::ipc
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <optional>
+
+#include <nngpp/socket_view.h>
+
+#include "Heartbeat.h"
+#include "Protocol.h"
+
+namespace ambilink::ipc {
+
+/// @brief Animation info sent by the Blender add-on for rendering.
+struct AnimationInfo
+{
+    size_t frame_count{0};
+    float fps{0};
+    /// @brief changes whenever rendering location data may have changed, 0
+    /// if not supported by the add-on.
+    uint64_t revision{0};
+};
+
+/**
+ * @brief Offline render shared by all instances in the process. Use via
+ * juce::SharedResourcePointer.
+ *
+ * The first instance to join sends PREPARE_TO_RENDER and GET_ANIMATION_INFO,
+ * the rest reuse the cached animation info, so starting a render costs two
+ * requests per process instead of two per instance. INFORM_RENDER_FINISHED is
+ * only sent when the last instance leaves.
+ */
+class RenderSession
+{
+    std::mutex _mu{};
+    size_t _participant_count{0};
+    std::optional<AnimationInfo> _animation_info{};
+
+public:
+    RenderSession() = default;
+    RenderSession(const RenderSession&) = delete;
+    RenderSession& operator=(const RenderSession&) = delete;
+
+    /**
+     * @brief Joins the render session, starting it if needed. Blocks while
+     * another instance is starting the session.
+     *
+     * @param reqrep_sock used to start the session if this is the first
+     * participant.
+     * @param heartbeat records the replies.
+     * @param server_info capabilities of the add-on.
+     * @throws nng::exception, exceptions::Base if starting the session
+     * fails, the caller doesn't join the session in that case.
+     */
+    AnimationInfo join(nng::socket_view reqrep_sock, Heartbeat& heartbeat,
+                       const ServerInfo& server_info);
+
+    /**
+     * @brief Leaves the render session. If this was the last participant,
+     * sends INFORM_RENDER_FINISHED via `reqrep_sock` (if provided).
+     *
+     * @throws nng::exception if the request fails, the caller has left the
+     * session regardless.
+     */
+    void leave(std::optional<nng::socket_view> reqrep_sock,
+               Heartbeat& heartbeat);
+};
+
+} // namespace ambilink::ipc
@@ -0,0 +1,124 @@
+#include "SharedPositions.h"
+#include "Constants.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <juce_core/juce_core.h>
+#include <spdlog/spdlog.h>
+
+#if !JUCE_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ambilink::ipc {
+namespace {
+/// @brief number of attempts to read a slot before giving up.
+constexpr int max_slot_read_attempts = 4;
+
+uint32_t slotChecksum(uint32_t seq, const uint32_t (&data_words)[5]) {
+    uint32_t retval = seq;
+    for (auto word : data_words) retval ^= word;
+    return retval;
+}
+} // namespace
+
+std::optional<SharedPositionSample>
+  readSharedPositionSlot(const SharedPositionSlot& slot) {
+    for (int attempt = 0; attempt < max_slot_read_attempts; attempt++) {
+        const auto seq_before = slot.seq.load(std::memory_order_acquire);
+        if (seq_before == 0) return std::nullopt;
+        if (seq_before & 1) continue;
+
+        uint32_t check;
+        // location[3], then the two halves of timestamp_ns
+        uint32_t data_words[5];
+        std::memcpy(&check, &slot.check, sizeof(check));
+        std::memcpy(data_words, &slot.location, sizeof(slot.location));
+        std::memcpy(data_words + 3, &slot.timestamp_ns,
+                    sizeof(slot.timestamp_ns));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != seq_before) continue;
+        if (slotChecksum(seq_before, data_words) != check) continue;
+
+        SharedPositionSample sample{};
+        std::memcpy(&sample.location, data_words, sizeof(slot.location));
+        std::memcpy(&sample.timestamp_ns, data_words + 3,
+                    sizeof(sample.timestamp_ns));
+        sample.seq = seq_before;
+        return sample;
+    }
+    return std::nullopt;
+}
+
+SharedPositionSegment::~SharedPositionSegment() {
+#if !JUCE_WINDOWS
+    for (auto&& mapping : _mappings) {
+        munmap(mapping.address, mapping.size);
+    }
+#endif
+}
+
+const SharedPositionSlot* SharedPositionSegment::getSlot(AmbilinkID id) {
+#if JUCE_WINDOWS
+    juce::ignoreUnused(id);
+    return nullptr;
+#else
+    std::lock_guard guard{_mu};
+
+    const int fd = shm_open(constants::shared_positions_name, O_RDONLY, 0);
+    if (fd == -1) return nullptr;
+
+    struct stat segment_stat {};
+    if (fstat(fd, &segment_stat) == -1
+        || static_cast<size_t>(segment_stat.st_size)
+             < sizeof(SharedPositionSegmentHeader)) {
+        close(fd);
+        return nullptr;
+    }
+
+    const auto inode = static_cast<uint64_t>(segment_stat.st_ino);
+    const auto mapping_it
+      = std::find_if(_mappings.begin(), _mappings.end(),
+                     [inode](const Mapping& m) { return m.inode == inode; });
+
+    Mapping mapping{};
+    if (mapping_it != _mappings.end()) {
+        close(fd);
+        mapping = *mapping_it;
+    } else {
+        const auto size = static_cast<size_t>(segment_stat.st_size);
+        void* address = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (address == MAP_FAILED) {
+            spdlog::error("Failed to map shared position segment.");
+            return nullptr;
+        }
+        mapping = {address, size, inode};
+        _mappings.emplace_back(mapping);
+    }
+
+    const auto* header
+      = static_cast<const SharedPositionSegmentHeader*>(mapping.address);
+    if (header->magic != SharedPositionSegmentHeader::expected_magic
+        || header->layout_version
+             != SharedPositionSegmentHeader::expected_layout_version
+        || id >= header->slot_count
+        || sizeof(SharedPositionSegmentHeader)
+               + header->slot_count * sizeof(SharedPositionSlot)
+             > mapping.size) {
+        return nullptr;
+    }
+
+    const auto* slots = reinterpret_cast<const SharedPositionSlot*>(
+      static_cast<const uint8_t*>(mapping.address)
+      + sizeof(SharedPositionSegmentHeader));
+    return slots + id;
+#endif
+}
+
+} // namespace ambilink::ipc
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#include <DataTypes.h>
+
+namespace ambilink::ipc {
+
+/**
+ * @brief Header of the shared memory segment the Blender add-on writes object
+ * positions to. Layout must match `shared_positions.py`.
+ */
+struct SharedPositionSegmentHeader
+{
+    constexpr static uint32_t expected_magic = 0x4C424D41; // "AMBL"
+    constexpr static uint16_t expected_layout_version = 1;
+
+    uint32_t magic;
+    uint16_t layout_version;
+    uint16_t reserved0;
+    uint32_t slot_count;
+    uint8_t reserved1[52];
+};
+static_assert(sizeof(SharedPositionSegmentHeader) == 64);
+
+/**
+ * @brief Per-object slot, indexed by AmbilinkID, written by the Blender add-on
+ * under a seqlock: `seq` is odd while the slot is being written, and `check`
+ * is the XOR of `seq` and all data words, which detects torn reads even if the
+ * add-on's plain stores become visible out of order.
+ */
+struct SharedPositionSlot
+{
+    std::atomic<uint32_t> seq;
+    uint32_t check;
+    float location[3];
+    uint32_t reserved;
+    uint64_t timestamp_ns;
+};
+static_assert(sizeof(SharedPositionSlot) == 32);
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+/// @brief a consistent copy of a SharedPositionSlot.
+struct SharedPositionSample
+{
+    /// @brief camera space location of the object.
+    glm::vec3 location;
+    /// @brief time of the update (unix time in nanoseconds).
+    uint64_t timestamp_ns;
+    /// @brief seqlock counter value, changes with each update.
+    uint32_t seq;
+};
+
+/**
+ * @brief Reads a slot without blocking (suitable for the real-time thread).
+ *
+ * @return std::nullopt if the slot has never been written or a consistent
+ * copy couldn't be made because it is being written.
+ */
+std::optional<SharedPositionSample>
+  readSharedPositionSlot(const SharedPositionSlot& slot);
+
+/**
+ * @brief Process-wide mapping of the add-on's shared position segment. Use via
+ * juce::SharedResourcePointer.
+ *
+ * Mappings are only released on destruction, so slot pointers handed out stay
+ * valid while any SharedResourcePointer to the segment exists, even if
+ * Blender recreates the segment in the meantime.
+ */
+class SharedPositionSegment
+{
+    struct Mapping
+    {
+        void* address;
+        size_t size;
+        uint64_t inode;
+    };
+
+    std::mutex _mu{};
+    std::vector<Mapping> _mappings{};
+
+public:
+    SharedPositionSegment() = default;
+    SharedPositionSegment(const SharedPositionSegment&) = delete;
+    SharedPositionSegment& operator=(const SharedPositionSegment&) = delete;
+    ~SharedPositionSegment();
+
+    /**
+     * @brief Returns the slot for `id` in the segment currently published by
+     * the Blender add-on, mapping it if it wasn't mapped yet. Not real-time
+     * safe.
+     *
+     * @return nullptr if the segment doesn't exist, has an unexpected layout,
+     * or shared memory isn't supported on this platform.
+     */
+    const SharedPositionSlot* getSlot(AmbilinkID id);
+};
+
+} // namespace ambilink::ipc
@@ -5,46 +5,175 @@
 #include <ValueIDs.h>
 #include "State.h"
 
-namespace ambilink::ipc::state {
+#include <Utility/Utils.h>
+
+#include <chrono>
+#include <map>
+#include <optional>
 
-juce::StringArray getCurrentObjectList(nng::socket_view& reqrep_sock) {
-    auto request_data = encodeReqRepRequest(constants::ReqRepCommand::OBJ_LIST);
-    reqrep_sock.send(nng::view{request_data.data(), request_data.size()});
+namespace ambilink::ipc::state {
+namespace {
+/// @brief Blender add-ons that don't know HELLO never reply to it, so it's
+/// sent with a shorter timeout than other requests.
+constexpr std::chrono::milliseconds hello_recv_timeout{1000};
+} // namespace
 
-    auto reply_data_reader = DataReader{reqrep_sock.recv()};
+juce::StringArray getCurrentObjectList(nng::socket_view& reqrep_sock,
+                                       Heartbeat& heartbeat) {
+    auto reply_data_reader
+      = sendRequest(reqrep_sock, heartbeat,
+                    makeReqRepRequest(constants::ReqRepCommand::OBJ_LIST));
     checkReplyStatus(reply_data_reader.read<constants::ReqRepStatusCode>());
 
     return decodeObjectList(reply_data_reader);
 }
 
-void dispatchObjListUpdCommand(StateBase& curr_state,
-                               events::Dispatcher& dispatcher,
-                               nng::socket_view& reqrep_sock) {
-    dispatcher.dispatch<commands::UpdateObjectList>(
-      [&reqrep_sock, &curr_state](const commands::UpdateObjectList&) {
-          curr_state.queuePropUpdate(ids::object_list,
-                                     getCurrentObjectList(reqrep_sock));
+namespace {
+/**
+ * @brief Filters and pages the object list on the client, for Blender add-ons
+ * that don't support OBJ_LIST_QUERY. Matches are ordered the same way as by
+ * the add-on - by the position of the match, then by the order in the scene.
+ */
+ObjectListPage::Ptr queryObjectListLocally(nng::socket_view& reqrep_sock,
+                                           Heartbeat& heartbeat,
+                                           const commands::QueryObjectList& cmd) {
+    const auto all_objects = getCurrentObjectList(reqrep_sock, heartbeat);
+    const auto query = cmd.query.toLowerCase();
+
+    std::map<int, std::vector<juce::String>> matches_by_index{};
+    for (const auto& object_name : all_objects) {
+        auto index = object_name.toLowerCase().indexOf(query);
+        if (index == -1) continue;
+        matches_by_index[index].emplace_back(object_name);
+    }
+
+    ObjectListPage::Ptr page = new ObjectListPage{};
+    page->query = cmd.query;
+    page->offset = cmd.offset;
+    for (auto&& [_, matches] : matches_by_index) {
+        for (auto&& match : matches) {
+            if (page->total_count >= cmd.offset
+                && page->total_count - cmd.offset < cmd.limit) {
+                page->names.add(match);
+            }
+            page->total_count++;
+        }
+    }
+    return page;
+}
+
+ObjectListPage::Ptr queryObjectList(nng::socket_view& reqrep_sock,
+                                    Heartbeat& heartbeat,
+                                    const ServerInfo& server_info,
+                                    const commands::QueryObjectList& cmd) {
+    if (!server_info.supports(constants::Capability::OBJ_LIST_QUERY))
+        return queryObjectListLocally(reqrep_sock, heartbeat, cmd);
+
+    auto request_data_writer
+      = makeReqRepRequest(constants::ReqRepCommand::OBJ_LIST_QUERY);
+    request_data_writer.write(cmd.known_version);
+    request_data_writer.write(cmd.offset);
+    request_data_writer.write(cmd.limit);
+    writeObjectName(request_data_writer, cmd.query);
+
+    auto reply_data_reader
+      = sendRequest(reqrep_sock, heartbeat, std::move(request_data_writer));
+    checkReplyStatus(reply_data_reader.read<constants::ReqRepStatusCode>());
+
+    return decodeObjectListPage(reply_data_reader, cmd.query, cmd.offset);
+}
+} // namespace
+
+void dispatchObjListQueryCommand(StateBase& curr_state,
+                                 events::Dispatcher& dispatcher,
+                                 nng::socket_view& reqrep_sock,
+                                 Heartbeat& heartbeat) {
+    dispatcher.dispatch<commands::QueryObjectList>(
+      [&reqrep_sock, &heartbeat,
+       &curr_state](const commands::QueryObjectList& cmd) {
+          if (auto page = queryObjectList(reqrep_sock, heartbeat,
+                                          curr_state.getServerInfo(), cmd))
+              curr_state.queuePropUpdate(ids::object_list_page, page.get());
           return true;
       });
 }
 
+ServerInfo sendHelloRequest(nng::socket_view& reqrep_sock,
+                            Heartbeat& heartbeat) {
+    auto request_data_writer
+      = makeReqRepRequest(constants::ReqRepCommand::HELLO);
+    request_data_writer.write(constants::protocol_version);
+    request_data_writer.write(constants::client_capabilities);
+
+    const auto recv_timeout = reqrep_sock.get_opt_ms(NNG_OPT_RECVTIMEO);
+    reqrep_sock.set_opt_ms(NNG_OPT_RECVTIMEO, hello_recv_timeout.count());
+    utils::OnScopeExit restore_recv_timeout{[&reqrep_sock, recv_timeout]() {
+        reqrep_sock.set_opt_ms(NNG_OPT_RECVTIMEO, recv_timeout);
+    }};
+
+    std::optional<DataReader> reply{};
+    try {
+        reply = sendRequest(reqrep_sock, heartbeat,
+                            std::move(request_data_writer));
+    } catch (const nng::exception& e) {
+        // Add-ons older than HELLO fail to decode the command and don't reply,
+        // the next request abandons this one.
+        if (e.get_error() != nng::error::timedout) throw;
+        return {};
+    }
+    auto& reply_data_reader = *reply;
+    const auto status_code
+      = reply_data_reader.read<constants::ReqRepStatusCode>();
+    if (status_code == constants::ReqRepStatusCode::UNKNOWN_COMMAND) return {};
+    checkReplyStatus(status_code);
+
+    ServerInfo server_info{};
+    server_info.protocol_version = reply_data_reader.read<uint16_t>();
+    server_info.capabilities = reply_data_reader.read<uint32_t>();
+    return server_info;
+}
+
+constants::SubFlags getSubFlags(const SubscribedObjectInfo& object_info) {
+    if (object_info.position_slot)
+        return constants::SubFlags::SHARED_MEMORY_POSITIONS;
+    if (object_info.world_space_positions)
+        return constants::SubFlags::WORLD_SPACE_POSITIONS;
+    return object_info.frame_snapshots ? constants::SubFlags::FRAME_SNAPSHOTS
+                                       : constants::SubFlags::NONE;
+}
+
 void sendObjectUnsubRequest(nng::socket_view& reqrep_sock,
-                            AmbilinkID object_to_unsub_from) {
-    auto request_data
-      = encodeReqRepRequest(constants::ReqRepCommand::OBJ_UNSUB,
-                            &object_to_unsub_from, sizeof(AmbilinkID));
-    reqrep_sock.send(nng::view{request_data.data(), request_data.size()});
+                            Heartbeat& heartbeat,
+                            const SubscribedObjectInfo& object_to_unsub_from) {
+    sendObjectUnsubRequest(reqrep_sock, heartbeat, object_to_unsub_from.id,
+                           getSubFlags(object_to_unsub_from));
+}
+
+void sendObjectUnsubRequest(nng::socket_view& reqrep_sock,
+                            Heartbeat& heartbeat, AmbilinkID id,
+                            constants::SubFlags sub_flags) {
+    auto request_data_writer
+      = makeReqRepRequest(constants::ReqRepCommand::OBJ_UNSUB, id);
+    request_data_writer.write(sub_flags);
+
+    auto reply_data_reader
+      = sendRequest(reqrep_sock, heartbeat, std::move(request_data_writer));
+    checkReplyStatus(reply_data_reader.read<constants::ReqRepStatusCode>());
+}
 
-    auto reply_data = reqrep_sock.recv();
-    checkReplyStatus(
-      constants::ReqRepStatusCode{*static_cast<uint8_t*>(reply_data.data())});
+DataReader sendRequest(nng::socket_view& reqrep_sock, Heartbeat& heartbeat,
+                       DataWriter&& request) {
+    reqrep_sock.send(std::move(request).release_msg());
+    DataReader reply{reqrep_sock.recv_msg()};
+    heartbeat.onContact();
+    return reply;
 }
 
 DataReader sendSimpleCommand(nng::socket_view& reqrep_sock,
+                             Heartbeat& heartbeat,
                              constants::ReqRepCommand command) {
-    auto request_data = encodeReqRepRequest(command);
-    reqrep_sock.send(nng::view{request_data.data(), request_data.size()});
-    auto reply_data_reader = DataReader{reqrep_sock.recv()};
+    auto reply_data_reader
+      = sendRequest(reqrep_sock, heartbeat, makeReqRepRequest(command));
     checkReplyStatus(reply_data_reader.read<constants::ReqRepStatusCode>());
     return reply_data_reader;
 }
@@ -7,32 +7,70 @@
 #include <Events/Consumers.h>
 #include <IPC/Constants.h>
 #include <IPC/ByteIO.h>
+#include <IPC/Heartbeat.h>
+#include <IPC/Protocol.h>
+#include <IPC/SharedPositions.h>
 
 namespace ambilink::ipc::state {
 class StateBase;
 
-/// @brief if the dispatcher contains an UpdateObjectList command, requests
-/// the object list and schedules a prop update via `curr_state`.
-void dispatchObjListUpdCommand(StateBase& curr_state,
-                               events::Dispatcher& dispatcher,
-                               nng::socket_view& reqrep_sock);
+struct SubscribedObjectInfo
+{
+    AmbilinkID id;
+    juce::String name;
+    /// @brief slot of the object in the shared position segment, nullptr if
+    /// positions are received via pub/sub.
+    const SharedPositionSlot* position_slot{nullptr};
+    /// @brief positions are received in FRAME_SNAPSHOT messages.
+    bool frame_snapshots{false};
+    /// @brief positions are received in world space, see
+    /// constants::SubFlags::WORLD_SPACE_POSITIONS.
+    bool world_space_positions{false};
+    /// @brief world oriented encoding was enabled at subscription.
+    bool world_oriented{false};
+};
+
+/// @brief if the dispatcher contains a QueryObjectList command, requests the
+/// page of matching object names and schedules a prop update via `curr_state`
+/// unless the list is unchanged since the version known by the sender.
+void dispatchObjListQueryCommand(StateBase& curr_state,
+                                 events::Dispatcher& dispatcher,
+                                 nng::socket_view& reqrep_sock,
+                                 Heartbeat& heartbeat);
+
+/// @brief sends a HELLO request with the plugin's protocol version and
+/// capabilities. Returns a default ServerInfo (version 0, no capabilities) if
+/// the Blender add-on doesn't support HELLO, i.e. replies UNKNOWN_COMMAND or
+/// doesn't reply at all.
+ServerInfo sendHelloRequest(nng::socket_view& reqrep_sock,
+                            Heartbeat& heartbeat);
+
+/// @brief returns the OBJ_SUB/OBJ_UNSUB flags matching `object_info`.
+constants::SubFlags getSubFlags(const SubscribedObjectInfo& object_info);
 
 /// @brief sends unsub request, throws if reply status is not SUCCESS.
 void sendObjectUnsubRequest(nng::socket_view& reqrep_sock,
-                            AmbilinkID object_to_unsub_from);
+                            Heartbeat& heartbeat,
+                            const SubscribedObjectInfo& object_to_unsub_from);
+
+/// @brief sends unsub request for an object subscribed to with `sub_flags`,
+/// throws if reply status is not SUCCESS.
+void sendObjectUnsubRequest(nng::socket_view& reqrep_sock,
+                            Heartbeat& heartbeat, AmbilinkID id,
+                            constants::SubFlags sub_flags);
+
+/// @brief sends the request written by `request`, returns a DataReader with
+/// the reply data (status byte not read). Records the reply in `heartbeat`.
+DataReader sendRequest(nng::socket_view& reqrep_sock, Heartbeat& heartbeat,
+                       DataWriter&& request);
 
 /// @brief sends a simple (containing only the command id) command, throws if
 /// reply status is not SUCCESS. Returns a DataReader with the reply data with
 /// the status byte already read.
 DataReader sendSimpleCommand(nng::socket_view& reqrep_sock,
+                             Heartbeat& heartbeat,
                              constants::ReqRepCommand command);
 
-struct SubscribedObjectInfo
-{
-    AmbilinkID id;
-    juce::String name;
-};
-
 /**
  *@brief Allows state objects to control the subscriber thread without directly
  *referencing the IPCClient.
@@ -43,6 +81,16 @@ struct SubThreadController
     std::function<void()> stop;
 };
 
+/**
+ * @brief Allows state objects to wake the Req/Rep thread, which otherwise
+ * sleeps until a command is queued or the state's next wakeup time.
+ */
+struct RequestorThreadController
+{
+    /// @brief can be called from any thread.
+    std::function<void()> wake;
+};
+
 /// @brief Helper base class for states that hold a SubscribedObjectInfo
 class SubscribedObjectInfoHolder
 {
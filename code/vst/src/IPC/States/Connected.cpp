@@ -19,12 +19,14 @@ Connected::Connected(const Disconnected& prev_state,
   : State(prev_state, SupportedCommands{}) {
     _reqrep_sock.dial(constants::reqrep_addr);
     pubsub_sock.dial(constants::pubsub_addr);
+    _server_info = sendHelloRequest(_reqrep_sock, getHeartbeat());
 }
 
 Connected::Connected(const Subscribed& prev_state)
   : State(prev_state, SupportedCommands{}) {
     _sub_thread_ctrl.stop();
-    sendObjectUnsubRequest(_reqrep_sock, prev_state.getObjectInfo().id);
+    sendObjectUnsubRequest(_reqrep_sock, getHeartbeat(),
+                           prev_state.getObjectInfo());
     queuePropUpdate(ids::object_name, {});
 }
 
@@ -43,7 +45,8 @@ std::unique_ptr<StateBase>
                             std::function<bool()>) {
     events::Dispatcher dispatcher(command);
 
-    dispatchObjListUpdCommand(*this, dispatcher, _reqrep_sock);
+    dispatchObjListQueryCommand(*this, dispatcher, _reqrep_sock,
+                                getHeartbeat());
 
     std::unique_ptr<StateBase> next_state{nullptr};
     dispatcher.dispatch<commands::SubscribeToObject>(
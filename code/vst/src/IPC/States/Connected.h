@@ -15,11 +15,12 @@ namespace ambilink::ipc::state {
  */
 class Connected : public State<Connected>
 {
-    using SupportedCommands = utils::TypeList<commands::UpdateObjectList,
+    using SupportedCommands = utils::TypeList<commands::QueryObjectList,
                                               commands::SubscribeToObject>;
 public:
     /**
-     * @brief Tries to initialise communication with a blender plugin instance.
+     * @brief Tries to initialise communication with a blender plugin instance,
+     * and exchanges protocol versions and capabilities with it.
      * @throws nng::exception if connection unsuccesful
      */
     Connected(const Disconnected& prev_state, nng::socket_view pubsub_sock);
@@ -13,14 +13,26 @@ class Disconnected : public State<Disconnected>
 {
     nng::socket_view _pubsub_sock;
 
+    /*
+    `nng_close` would block indefenitely when an instance of the IPC
+    Client was being destroyed, but 1 or more other instances were
+    still trying to connect. This is fixed by adding a short delay
+    between reconnect attempts.
+    */
+    constexpr static std::chrono::milliseconds reconnect_interval{250};
+    std::chrono::steady_clock::time_point _next_connect_attempt
+      = std::chrono::steady_clock::now();
+
 public:
     Disconnected(nng::socket_view reqrep_sock, nng::socket_view pubsub_sock,
-                 std::atomic<Direction>& current_direction,
-                 std::atomic<Distance>& current_distance,
+                 lock_free::SeqLock<math::MotionState>& current_motion,
+                 std::atomic<const SharedPositionSlot*>& shared_position_slot,
                    juce::ValueTree& other_plugin_state,
-                 const SubThreadController& sub_thread_ctrl)
-      : State(reqrep_sock, current_direction, current_distance,
-              other_plugin_state, sub_thread_ctrl, utils::TypeList{}),
+                 const SubThreadController& sub_thread_ctrl,
+                 const RequestorThreadController& requestor_thread_ctrl)
+      : State(reqrep_sock, current_motion, shared_position_slot,
+              other_plugin_state, sub_thread_ctrl, requestor_thread_ctrl,
+              utils::TypeList{}),
         _pubsub_sock(pubsub_sock) {}
 
     std::unique_ptr<StateBase>
@@ -28,10 +40,19 @@ public:
                      std::function<bool()> should_stop) final;
     void onPubSubCommand(constants::PubSubMsgType msg,
                          DataReader& reader) final;
+    /// @brief Attempts to connect if the reconnect interval has elapsed.
     std::unique_ptr<StateBase>
       reqRepThreadIdleUpdate(std::function<bool()> should_stop) final;
+    std::optional<std::chrono::steady_clock::time_point>
+      nextIdleUpdateTime() const final {
+        return _next_connect_attempt;
+    }
 
     void sendPingRequest() final {} // Do not ping when already disconnected.
+    std::optional<std::chrono::steady_clock::time_point>
+      nextPingTime() const final {
+        return std::nullopt;
+    }
 
     implement_GetStateName(Disconnected);
 };
@@ -22,11 +22,15 @@ ErrorState::ErrorState(std::exception_ptr error, const StateBase& prev_state)
         || prev_state_id == Subscribed::id) {
         _sub_thread_ctrl.stop();
         try {
+            if (prev_state_id == OfflineRendering::id) {
+                dynamic_cast<const OfflineRendering&>(prev_state)
+                  .leaveRenderSession(_reqrep_sock);
+            }
             auto object_info
               = dynamic_cast<const SubscribedObjectInfoHolder&>(prev_state)
                   .getObjectInfo();
             spdlog::debug("Unsubscribing from object {}({}).", object_info.name.toStdString(), object_info.id);
-            sendObjectUnsubRequest(_reqrep_sock, object_info.id);
+            sendObjectUnsubRequest(_reqrep_sock, getHeartbeat(), object_info);
         } catch (const std::exception& e) {
             spdlog::error("Error while unsubscribing from object: {}", e.what());
         }
@@ -15,8 +15,7 @@ ObjectDeleted::ObjectDeleted(const OfflineRendering& prev_state)
   : State(prev_state, SupportedCommands{}),
     SubscribedObjectInfoHolder(prev_state) {
     queuePropUpdate(ids::object_deleted, true);
-    sendSimpleCommand(_reqrep_sock,
-                      constants::ReqRepCommand::INFORM_RENDER_FINISHED);
+    prev_state.leaveRenderSession(_reqrep_sock);
 }
 
 std::unique_ptr<StateBase>
@@ -25,7 +24,8 @@ std::unique_ptr<StateBase>
     events::Dispatcher dispatcher(command);
     std::unique_ptr<StateBase> next_state{nullptr};
 
-    dispatchObjListUpdCommand(*this, dispatcher, _reqrep_sock);
+    dispatchObjListQueryCommand(*this, dispatcher, _reqrep_sock,
+                                getHeartbeat());
 
     dispatcher.dispatch<commands::SubscribeToObject>(
       [this, &next_state](const commands::SubscribeToObject& cmd) {
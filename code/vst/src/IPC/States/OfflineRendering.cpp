@@ -10,16 +10,16 @@
 
 namespace ambilink::ipc::state {
 
-OfflineRendering::OfflineRendering(const Subscribed& prev_state)
+OfflineRendering::OfflineRendering(float start_time_secs,
+                                   const Subscribed& prev_state)
   : State(prev_state, SupportedCommands{}),
     SubscribedObjectInfoHolder(prev_state) {
-    sendSimpleCommand(_reqrep_sock,
-                      constants::ReqRepCommand::PREPARE_TO_RENDER);
-    auto reply_data_reader = sendSimpleCommand(
-      _reqrep_sock, constants::ReqRepCommand::GET_ANIMATION_INFO);
+    const auto animation_info
+      = _render_session->join(_reqrep_sock, getHeartbeat(), _server_info);
 
-    _frame_count = reply_data_reader.read<size_t>();
-    _fps = reply_data_reader.read<float>();
+    _animation_revision = animation_info.revision;
+    _frame_count = animation_info.frame_count;
+    _fps = animation_info.fps;
     _animation_length_seconds = _frame_count / _fps;
 
     _num_slices
@@ -28,16 +28,35 @@ OfflineRendering::OfflineRendering(const Subscribed& prev_state)
     if (_last_slice_frame_count == 0)
         _last_slice_frame_count = max_frames_per_slice;
 
-    _slices.resize(_num_slices);
+    _slices = std::vector<RenderingDataSlice>(_num_slices);
 
     _max_slice_length_seconds = static_cast<float>(max_frames_per_slice) / _fps;
 
-    _first_fetch_time = std::chrono::steady_clock::now() + first_fetch_delay;
+    try {
+        warmUp(start_time_secs);
+    } catch (...) {
+        // Destructor isn't called if the constructor throws.
+        _left_render_session = true;
+        _render_session->leave(std::nullopt, getHeartbeat());
+        throw;
+    }
 }
 
-DirectionWithDistance
-  OfflineRendering::getDirectionAndDistanceAtTime(float time_secs) {
+OfflineRendering::~OfflineRendering() {
+    // Connection lost or error, the add-on can't be informed.
+    if (!_left_render_session.exchange(true))
+        _render_session->leave(std::nullopt, getHeartbeat());
+}
+
+void OfflineRendering::leaveRenderSession(nng::socket_view reqrep_sock) const {
+    if (_left_render_session.exchange(true)) return;
+    _render_session->leave(reqrep_sock, getHeartbeat());
+}
+
+std::pair<size_t, size_t>
+  OfflineRendering::sliceAndFrameAtTime(float time_secs) const {
     jassert(time_secs >= 0);
+    time_secs = std::max(time_secs, 0.0f);
     size_t target_slice = std::floor(time_secs / _max_slice_length_seconds);
     size_t target_frame
       = std::floor(std::fmod(time_secs * _fps, max_frames_per_slice));
@@ -48,51 +67,152 @@ DirectionWithDistance
     } else if (target_slice == _num_slices - 1) {
         target_frame = std::min(_last_slice_frame_count - 1, target_frame);
     }
+    return {target_slice, target_frame};
+}
 
-    while (target_slice >= _slice_to_fetch) {
-        // error occured or object deleted, return ASAP to avoid blocking state
-        // transition due to state change mutex locked by ScopedThreadAccess.
-        if (_rendering_mode_aborted) return {};
-
-        // Busy wait for req/rep thread to fetch data.
-        std::this_thread::sleep_for(std::chrono::milliseconds{100});
+DirectionWithDistance
+  OfflineRendering::getDirectionAndDistanceAtTime(float time_secs) {
+    if (_num_slices == 0) return {};
+    const auto [target_slice, target_frame] = sliceAndFrameAtTime(time_secs);
+    auto& slice = _slices[target_slice];
+
+    // Must be set before checking the state, so the req/rep thread either
+    // sees it and keeps the slice, or has started evicting it and it's seen
+    // as not READY here (see evictSlices).
+    // Reading a new slice also moves the cache window for the req/rep thread.
+    if (_slice_being_read.exchange(target_slice) != target_slice)
+        _requestor_thread_ctrl.wake();
+
+    if (slice.state.load() != SliceState::READY) {
+        _requestor_thread_ctrl.wake();
+        while (slice.state.load() != SliceState::READY) {
+            // error occured or object deleted, return ASAP to avoid blocking
+            // state transition due to state change mutex locked by
+            // ScopedThreadAccess.
+            if (_rendering_mode_aborted) return {};
+
+            // Busy wait for req/rep thread to fetch data.
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
     }
-
-    _slice_being_read = target_slice;
-    return _slices[target_slice].at(target_frame);
+    return (*slice.data)[target_frame];
 }
 
-void OfflineRendering::fetchSlice(size_t slice_to_fetch) {
-    DataWriter request_data_writer{};
-    request_data_writer.write(
+std::pair<constants::LocationDataEncoding, DataReader>
+  OfflineRendering::requestLocationData(size_t start_frame, size_t end_frame) {
+    if (_server_info.supports(
+          constants::Capability::ENCODED_LOCATION_DATA)) {
+        auto request_data_writer = makeReqRepRequest(
+          constants::ReqRepCommand::GET_RENDERING_LOCATION_DATA_ENCODED);
+        request_data_writer.write(_obj_info.id);
+        request_data_writer.write(start_frame);
+        request_data_writer.write(end_frame);
+        request_data_writer.write(
+          constants::LocationDataEncoding::QUANTIZED_DELTA_U16);
+
+        auto reply_data_reader
+          = sendRequest(_reqrep_sock, getHeartbeat(),
+                        std::move(request_data_writer));
+        checkReplyStatus(reply_data_reader.read<constants::ReqRepStatusCode>());
+        const auto encoding
+          = reply_data_reader.read<constants::LocationDataEncoding>();
+        return {encoding, std::move(reply_data_reader)};
+    }
+
+    auto request_data_writer = makeReqRepRequest(
       constants::ReqRepCommand::GET_RENDERING_LOCATION_DATA);
     request_data_writer.write(_obj_info.id);
-
-    const size_t start_frame = slice_to_fetch * max_frames_per_slice;
-    const size_t end_frame
-      = std::min((slice_to_fetch + 1) * max_frames_per_slice, _frame_count) - 1;
-    const auto slice_frame_count = end_frame - start_frame + 1;
-
     request_data_writer.write(start_frame);
     request_data_writer.write(end_frame);
 
-    auto request_data = std::move(request_data_writer).release_data();
+    auto reply_data_reader
+      = sendRequest(_reqrep_sock, getHeartbeat(),
+                    std::move(request_data_writer));
+    checkReplyStatus(reply_data_reader.read<constants::ReqRepStatusCode>());
+    return {constants::LocationDataEncoding::RAW_F32,
+            std::move(reply_data_reader)};
+}
 
-    _reqrep_sock.send(nng::view{request_data.data(), request_data.size()});
-    auto reply_data_reader = DataReader{_reqrep_sock.recv()};
+void OfflineRendering::fetchSlice(size_t slice_to_fetch) {
+    auto& slice = _slices[slice_to_fetch];
+    jassert(slice.state.load() == SliceState::EMPTY && !slice.data);
+
+    const TrajectoryCache::Key cache_key{_obj_info.id, _animation_revision,
+                                         slice_to_fetch};
+    if (_animation_revision != 0)
+        slice.data = _trajectory_cache->find(cache_key);
+
+    if (!slice.data) {
+        const size_t start_frame = slice_to_fetch * max_frames_per_slice;
+        const size_t end_frame
+          = std::min((slice_to_fetch + 1) * max_frames_per_slice, _frame_count)
+            - 1;
+        const auto slice_frame_count = end_frame - start_frame + 1;
+
+        auto [encoding, reply_data_reader]
+          = requestLocationData(start_frame, end_frame);
+
+        auto data = std::make_shared<std::vector<DirectionWithDistance>>();
+        data->reserve(slice_frame_count);
+        decodeRenderingLocationData(reply_data_reader, encoding,
+                                    slice_frame_count, *data);
+        slice.data = std::move(data);
+        if (_animation_revision != 0)
+            _trajectory_cache->insert(cache_key, slice.data);
+    }
+    slice.state.store(SliceState::READY);
+    _cached_slices.push_back(slice_to_fetch);
+}
 
-    checkReplyStatus(reply_data_reader.read<constants::ReqRepStatusCode>());
+std::optional<size_t> OfflineRendering::nextSliceToFetch() const {
+    const size_t slice_being_read = _slice_being_read;
+    const auto window_end
+      = std::min(_num_slices, slice_being_read + max_cached_slices);
+    for (size_t slice = slice_being_read; slice < window_end; slice++) {
+        if (_slices[slice].state.load() != SliceState::READY) return slice;
+    }
+    return std::nullopt;
+}
 
-    auto bytes
-      = reply_data_reader.readBytes(slice_frame_count * sizeof(glm::vec3));
-    auto locations = std::span<glm::vec3>(
-      reinterpret_cast<glm::vec3*>(bytes.data()), slice_frame_count);
+void OfflineRendering::evictSlices() {
+    // The window is moved back near the end of the animation, so everything
+    // stays cached if the whole animation fits.
+    const size_t window_start
+      = std::min(_slice_being_read.load(),
+                 _num_slices - std::min(_num_slices, max_cached_slices));
+    const size_t window_end = window_start + max_cached_slices;
+
+    std::erase_if(_cached_slices, [&](size_t slice_idx) {
+        if (slice_idx >= window_start && slice_idx < window_end) return false;
+
+        auto& slice = _slices[slice_idx];
+        slice.state.store(SliceState::EVICTING);
+        // The real-time thread sets `_slice_being_read` before checking the
+        // state, so if it didn't just switch to this slice, it won't read it.
+        if (_slice_being_read.load() == slice_idx) {
+            slice.state.store(SliceState::READY);
+            return false;
+        }
+        slice.data.reset();
+        slice.state.store(SliceState::EMPTY);
+        return true;
+    });
+}
+
+void OfflineRendering::warmUp(float start_time_secs) {
+    if (_num_slices == 0) return;
+    const auto start_slice = sliceAndFrameAtTime(start_time_secs).first;
+    _slice_being_read = start_slice;
 
-    jassert(_slices[slice_to_fetch].empty());
-    _slices[slice_to_fetch].reserve(slice_frame_count);
-    for (auto&& location : locations) {
-        _slices[slice_to_fetch].emplace_back(
-          math::directionFromCamSpaceLocation(location));
+    const auto warmup_frames
+      = static_cast<size_t>(std::ceil(warmup_seconds * _fps));
+    const auto warmup_slices = std::clamp<size_t>(
+      (warmup_frames + max_frames_per_slice - 1) / max_frames_per_slice, 1,
+      max_cached_slices);
+    const auto end_slice = std::min(start_slice + warmup_slices, _num_slices);
+
+    for (size_t slice = start_slice; slice < end_slice; slice++) {
+        fetchSlice(slice);
     }
 }
 
@@ -103,32 +223,13 @@ std::unique_ptr<StateBase>
             return std::make_unique<ObjectDeleted>(*this);
         }
 
-        // delay first fetch, so other plugin instances can transition to
-        // OfflineRendering state faster
-        if (!_first_fetch_done) {
-            if (std::chrono::steady_clock::now() < _first_fetch_time)
-                return nullptr;
-            else
-                _first_fetch_done = true;
-        }
-
-        while (_slice_to_fetch < _num_slices
-               && _slice_to_fetch - _slice_being_read + 1
-                    <= max_cached_slices) {
-            fetchSlice(_slice_to_fetch);
-            _slice_to_fetch++;
-        }
-
-        if (_num_slices <= max_cached_slices) return nullptr;
-
-        size_t slice_to_clear;
-        for (slice_to_clear = 0;
-             slice_to_clear
-             < std::min(_last_uncleared_slice + 1, _slice_being_read.load());
-             slice_to_clear++) {
-            _slices[slice_to_clear].clear();
+        // Evicting first keeps memory use within the limit. The slice being
+        // read is re-checked after every fetch, so a seek is served next.
+        evictSlices();
+        while (auto slice_to_fetch = nextSliceToFetch()) {
+            fetchSlice(*slice_to_fetch);
+            evictSlices();
         }
-        _last_uncleared_slice = slice_to_clear;
         return nullptr;
     } catch (...) {
         _rendering_mode_aborted.store(true);
@@ -143,7 +244,8 @@ std::unique_ptr<StateBase>
         events::Dispatcher dispatcher(command);
         std::unique_ptr<StateBase> next_state{nullptr};
 
-        dispatchObjListUpdCommand(*this, dispatcher, _reqrep_sock);
+        dispatchObjListQueryCommand(*this, dispatcher, _reqrep_sock,
+                                    getHeartbeat());
 
         dispatcher.dispatch<commands::DisableRenderingMode>(
           [this, &next_state](const commands::DisableRenderingMode&) {
@@ -167,11 +269,15 @@ void OfflineRendering::onPubSubCommand(constants::PubSubMsgType msg,
             case MsgType::OBJECT_DELETED:
                 _rendering_mode_aborted.store(true);
                 _should_switch_to_deleted_state.store(true);
+                _requestor_thread_ctrl.wake();
             case MsgType::OBJECT_RENAMED:
                 _obj_info.name = decodeObjectName(reader);
                 queuePropUpdate(ids::object_name, _obj_info.name);
                 break;
             case MsgType::OBJECT_POSITION_UPDATED:
+            case MsgType::FRAME_SNAPSHOT:
+            case MsgType::WORLD_SNAPSHOT:
+            case MsgType::CAMERA_MATRIX:
                 break;
         }
     } catch (...) {
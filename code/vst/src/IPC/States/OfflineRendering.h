@@ -2,19 +2,47 @@
 #include "State.h"
 
 #include <IPC/Commands.h>
+#include <IPC/RenderSession.h>
+#include <IPC/TrajectoryCache.h>
 
 namespace ambilink::ipc::state {
 
 static_assert(std::atomic<size_t>::is_always_lock_free);
 
+/// @brief State of a slice of rendering data.
+enum class SliceState : uint8_t
+{
+    /// @brief not fetched or evicted, may be fetched by the req/rep thread.
+    EMPTY,
+    /// @brief data can be read by the real-time thread.
+    READY,
+    /// @brief being evicted by the req/rep thread, must not be read.
+    EVICTING
+};
+
+/// @brief A slice of rendering data, `data` is only written by the req/rep
+/// thread while `state` isn't READY.
+struct RenderingDataSlice
+{
+    std::atomic<SliceState> state{SliceState::EMPTY};
+    /// @brief shared with TrajectoryCache.
+    TrajectoryCache::SliceData data{};
+};
+static_assert(std::atomic<SliceState>::is_always_lock_free);
+
 /**
  * @brief [IPC state]: Subscribed to object, and in offline rendering mode.
+ *
+ * Rendering data is fetched in slices, in any order: the req/rep thread keeps
+ * the slices from the one being read onward cached (up to the memory limit),
+ * and evicts slices outside of that window. Seeking, or rendering only part
+ * of the timeline, just changes the slice being read.
  */
 class OfflineRendering : public State<OfflineRendering>,
                          public SubscribedObjectInfoHolder
 {
     using SupportedCommands = utils::TypeList<commands::DisableRenderingMode,
-                                              commands::UpdateObjectList>;
+                                              commands::QueryObjectList>;
 
     /// @brief number of rendering data frames requested at once.
     constexpr static size_t max_frames_per_slice = 250;
@@ -26,11 +54,18 @@ class OfflineRendering : public State<OfflineRendering>,
     constexpr static size_t max_cached_slices
       = std::max<size_t>(max_cached_frames / max_frames_per_slice, 1);
 
-    // First rendering data request is delayed, so other plugin instances can
-    // transition to OfflineRendering state faster
-    constexpr static std::chrono::milliseconds first_fetch_delay{300};
-    std::chrono::steady_clock::time_point _first_fetch_time;
-    bool _first_fetch_done{false};
+    /// @brief length of rendering data fetched (from the render start
+    /// position) before entering the state, so the first rendering blocks
+    /// don't wait for data.
+    constexpr static float warmup_seconds = 5;
+
+    juce::SharedResourcePointer<RenderSession> _render_session{};
+    mutable std::atomic<bool> _left_render_session{false};
+
+    juce::SharedResourcePointer<TrajectoryCache> _trajectory_cache{};
+    /// @brief 0 if the add-on doesn't report revisions, slices aren't cached
+    /// across renders then.
+    uint64_t _animation_revision;
 
     float _fps;
     size_t _frame_count;
@@ -39,11 +74,13 @@ class OfflineRendering : public State<OfflineRendering>,
     size_t _last_slice_frame_count;
     float _max_slice_length_seconds;
 
-    size_t _last_uncleared_slice = 0;
+    /// @brief set by the real-time thread before checking the slice's state,
+    /// the req/rep thread never evicts this slice.
     std::atomic<size_t> _slice_being_read = 0;
-    std::atomic<size_t> _slice_to_fetch = 0;
 
-    std::vector<std::vector<DirectionWithDistance>> _slices{};
+    std::vector<RenderingDataSlice> _slices{};
+    /// @brief indices of READY slices, only accessed by the req/rep thread.
+    std::vector<size_t> _cached_slices{};
 
     // flag indicating that getDirectionAndDistanceAtTime should return ASAP
     // (possibly with incorrect data).
@@ -51,18 +88,59 @@ class OfflineRendering : public State<OfflineRendering>,
     std::atomic<bool> _should_switch_to_deleted_state{false};
 
     /**
-     * @brief requests the specified slice of rendering data, calculated
-     * direction and distance from camera space coordinates, and stores the
-     * result in `_slices`.
+     * @brief sends a location data request for the given frames, compressed if
+     * the Blender add-on reported the ENCODED_LOCATION_DATA capability. Returns the encoding of the reply and
+     * a DataReader positioned at the location data.
+     */
+    std::pair<constants::LocationDataEncoding, DataReader>
+      requestLocationData(size_t start_frame, size_t end_frame);
+
+    /**
+     * @brief takes the specified slice of rendering data from the trajectory
+     * cache, or requests it and calculates direction and distance from camera
+     * space coordinates. Stores the result in `_slices` and marks the slice
+     * READY.
      */
     void fetchSlice(size_t slice_to_fetch);
 
+    /**
+     * @brief Returns the first slice that isn't cached between the slice
+     * being read and the end of the cache window, if any.
+     */
+    std::optional<size_t> nextSliceToFetch() const;
+
+    /// @brief evicts cached slices outside of the cache window.
+    void evictSlices();
+
+    /**
+     * @brief Fetches the slices covering `warmup_seconds` of the animation
+     * from `start_time_secs` (at most `max_cached_slices`).
+     */
+    void warmUp(float start_time_secs);
+
+    /// @brief returns the slice and the frame in it for a time in the
+    /// animation, clamped to the last frame.
+    std::pair<size_t, size_t> sliceAndFrameAtTime(float time_secs) const;
+
 public:
     /**
-     * @brief Sends PREPARE_TO_RENDER request, gets animation info, calculates
-     * internal variables.
+     * @brief Joins the process-wide render session (which sends
+     * PREPARE_TO_RENDER and gets animation info if not started yet),
+     * calculates internal variables and fetches the slices from
+     * `start_time_secs` onward. Each
+     * instance transitions on its own req/rep thread, so all instances warm
+     * up in parallel.
+     */
+    OfflineRendering(float start_time_secs, const Subscribed& prev_state);
+    /// @brief leaves the render session if not done by a transition.
+    ~OfflineRendering();
+
+    /**
+     * @brief Leaves the process-wide render session, the last instance to
+     * leave sends INFORM_RENDER_FINISHED. Called by states transitioned to
+     * from OfflineRendering, only the first call has an effect.
      */
-    OfflineRendering(const Subscribed& prev_state);
+    void leaveRenderSession(nng::socket_view reqrep_sock) const;
 
     std::unique_ptr<StateBase>
       processCommand(ambilink::events::EventBase& command,
@@ -71,7 +149,7 @@ public:
     /**
      * @brief Get the direction and distance to the subscribed object at the
      * specified time in the animation. May block until the required data is
-     * received.
+     * received, if it isn't cached the req/rep thread fetches it first.
      *
      * @param time_secs time in the animation
      * @return DirectionWithDistance direction and distance to object
@@ -79,8 +157,8 @@ public:
     DirectionWithDistance getDirectionAndDistanceAtTime(float time_secs);
 
     /**
-     * @brief Continuously fetches rendering data from the Blender plugin and
-     * cleans up data that's no longer needed. Pauses if memory limit is
+     * @brief Fetches rendering data from the slice being read onward and
+     * evicts slices outside of the cache window. Pauses if memory limit is
      * reached.
      */
     std::unique_ptr<StateBase>
@@ -90,7 +168,8 @@ public:
                          DataReader& reader) final;
 
     void onShutdown() final {
-        sendObjectUnsubRequest(_reqrep_sock, _obj_info.id);
+        leaveRenderSession(_reqrep_sock);
+        sendObjectUnsubRequest(_reqrep_sock, getHeartbeat(), _obj_info);
     }
 
     implement_GetStateName(OfflineRendering);
@@ -7,21 +7,27 @@
 
 namespace ambilink::ipc::state {
 StateBase::StateBase(nng::socket_view reqrep_sock,
-                     std::atomic<Direction>& current_direction,
-                     std::atomic<Distance>& current_distance,
+                     lock_free::SeqLock<math::MotionState>& current_motion,
+                     std::atomic<const SharedPositionSlot*>& shared_position_slot,
                      juce::ValueTree& other_plugin_state,
-                     const SubThreadController& sub_thread_ctrl)
+                     const SubThreadController& sub_thread_ctrl,
+                     const RequestorThreadController& requestor_thread_ctrl)
   : _other_plugin_state(other_plugin_state), _reqrep_sock(reqrep_sock),
-    _curr_direction(current_direction), _curr_distance(current_distance),
-    _sub_thread_ctrl(sub_thread_ctrl) {}
+    _curr_motion(current_motion),
+    _shared_position_slot(shared_position_slot),
+    _sub_thread_ctrl(sub_thread_ctrl),
+    _requestor_thread_ctrl(requestor_thread_ctrl) {}
 
 StateBase::StateBase(const StateBase& other)
-  : _other_plugin_state(other._other_plugin_state), _reqrep_sock(other._reqrep_sock),
-    _curr_direction(other._curr_direction),
-    _curr_distance(other._curr_distance),
-    _sub_thread_ctrl(other._sub_thread_ctrl) {
-    _curr_direction = Direction{0,0};
-    _curr_distance = 0;
+  : _known_connection_lost_count(other._known_connection_lost_count),
+    _other_plugin_state(other._other_plugin_state), _reqrep_sock(other._reqrep_sock),
+    _curr_motion(other._curr_motion),
+    _shared_position_slot(other._shared_position_slot),
+    _sub_thread_ctrl(other._sub_thread_ctrl),
+    _requestor_thread_ctrl(other._requestor_thread_ctrl),
+    _server_info(other._server_info) {
+    _curr_motion.store({});
+    _shared_position_slot = nullptr;
 }
 
 StateBase::~StateBase() {
@@ -47,10 +53,26 @@ void StateBase::handleAsyncUpdate() {
     }
 }
 
+std::optional<std::chrono::steady_clock::time_point>
+  StateBase::nextWakeupTime() const {
+    const auto idle_update_time = nextIdleUpdateTime();
+    const auto ping_time = nextPingTime();
+    if (idle_update_time && ping_time)
+        return std::min(*idle_update_time, *ping_time);
+    return idle_update_time ? idle_update_time : ping_time;
+}
+
 void StateBase::sendPingRequest() {
-    if (auto now = std::chrono::steady_clock::now();
-        now - last_ping > ping_interval) {
-        sendSimpleCommand(_reqrep_sock, constants::ReqRepCommand::PING);
+    const auto now = std::chrono::steady_clock::now();
+    const auto connection_lost_count = _heartbeat->getConnectionLostCount();
+    const auto ping_time = nextPingTime();
+    if (!ping_time) return;
+
+    if (connection_lost_count != _known_connection_lost_count
+        || now >= *ping_time) {
+        _known_connection_lost_count = connection_lost_count;
+        sendSimpleCommand(_reqrep_sock, getHeartbeat(),
+                          constants::ReqRepCommand::PING);
         last_ping = now;
     }
 }
@@ -1,11 +1,19 @@
 #pragma once
 
+#include <chrono>
+#include <optional>
+
 #include "Common.h"
 #include <Events/Events.h>
 #include <ValueIDs.h>
 #include <Utility/IdGenerator.h>
 #include <IPC/Constants.h>
 #include <IPC/ByteIO.h>
+#include <IPC/Heartbeat.h>
+#include <IPC/SharedPositions.h>
+#include <LockFree/MPSCQueue.h>
+#include <LockFree/SeqLock.h>
+#include <Math/DeadReckoning.h>
 
 #include <nngpp/socket_view.h>
 #include <DataTypes.h>
@@ -43,8 +51,9 @@ class StateBase : private juce::AsyncUpdater
         juce::var new_value;
     };
 
-    /// @brief queue of scheduled ValueTree property updates
-    lock_free::Queue<PropUpdate, 100> _prop_update_queue;
+    /// @brief queue of scheduled ValueTree property updates, pushed to from
+    /// both the Req/Rep and the Subscriber thread.
+    lock_free::MPSCQueue<PropUpdate, 100> _prop_update_queue;
 
     /**
      * @brief Interval at which ping requests are sent to the Blender plugin.
@@ -56,43 +65,69 @@ class StateBase : private juce::AsyncUpdater
     std::chrono::steady_clock::time_point last_ping
       = std::chrono::steady_clock::now();
 
+    /// @brief connection health shared by all instances, pings are skipped
+    /// while other instances are receiving replies.
+    juce::SharedResourcePointer<Heartbeat> _heartbeat{};
+    /// @brief Heartbeat::getConnectionLostCount() at the last ping, a
+    /// different value means another instance lost the connection.
+    uint32_t _known_connection_lost_count{
+      _heartbeat->getConnectionLostCount()};
+
     juce::ValueTree _other_plugin_state;
 
 protected:
     /// @brief view over the reqrep sock, concrete states should use this to
     /// send requests.
     nng::socket_view _reqrep_sock;
-    /// @brief use to update current direction in real-time mode.
-    std::atomic<Direction>& _curr_direction;
-    /// @brief use to update current distance in real-time mode.
-    std::atomic<Distance>& _curr_distance;
+    /// @brief use to update the current location and velocity estimate in
+    /// real-time mode.
+    lock_free::SeqLock<math::MotionState>& _curr_motion;
+    /// @brief slot of the subscribed object in the shared position segment,
+    /// which the real-time thread reads instead of `_curr_motion` if not
+    /// nullptr.
+    std::atomic<const SharedPositionSlot*>& _shared_position_slot;
     /// @brief used to control
     const SubThreadController& _sub_thread_ctrl;
+    /// @brief used to wake the Req/Rep thread, e.g. when
+    /// reqRepThreadIdleUpdate has work to do.
+    const RequestorThreadController& _requestor_thread_ctrl;
+    /// @brief protocol version and capabilities of the Blender add-on, set
+    /// when connecting and carried over on state transitions.
+    ServerInfo _server_info{};
 
     /// @brief allows state implementations to read but not set properties.
     const juce::ValueTree& getOtherPluginState() { return _other_plugin_state; }
+    /// @brief connection health shared by all instances, pass to sendRequest
+    /// and the other request helpers.
+    Heartbeat& getHeartbeat() const { return *_heartbeat; }
 
 public:
     /// @brief get the state ID
     virtual StateID getId() const = 0;
 
+    /// @brief get the protocol version and capabilities of the Blender add-on.
+    const ServerInfo& getServerInfo() const { return _server_info; }
+
     /**
      * @brief Constructs a new StateBase
      *
      * @param reqrep_sock nng socket for states to send requests
-     * @param current_direction reference to the atomic Direction held by
-     * IPCClient, used for updating in real-time mode.
-     * @param current_distance reference to the atomic Distance held by
-     * IPCClient, used for updating in real-time mode.
+     * @param current_motion reference to the location and velocity estimate
+     * held by IPCClient, used for updating in real-time mode.
+     * @param shared_position_slot reference to the atomic slot pointer held by
+     * IPCClient, used for updating in real-time mode via shared memory.
      * @param other_plugin_state non-audio parameters of the plugin
      * @param sub_thread_ctrl for controlling the Subscriber thread managed by
      * IPCClient.
+     * @param requestor_thread_ctrl for waking the Req/Rep thread managed by
+     * IPCClient.
      */
     StateBase(nng::socket_view reqrep_sock,
-              std::atomic<Direction>& current_direction,
-              std::atomic<Distance>& current_distance,
+              lock_free::SeqLock<math::MotionState>& current_motion,
+              std::atomic<const SharedPositionSlot*>& shared_position_slot,
               juce::ValueTree& other_plugin_state,
-              const SubThreadController& sub_thread_ctrl);
+              const SubThreadController& sub_thread_ctrl,
+              const RequestorThreadController& requestor_thread_ctrl);
 
     /**
      * @brief Construct a new StateBase from an existing state. Used when
@@ -121,7 +156,11 @@ public:
       = 0;
 
     /**
-     * @brief Periodically called from reqRepThread when no events are queued.
+     * @brief Called from reqRepThread after queued events have been processed,
+     * each time the thread wakes up. The thread only wakes up when a command
+     * is queued, on state transitions, at the time returned by
+     * nextIdleUpdateTime or nextPingTime, or when woken via
+     * `_requestor_thread_ctrl`.
      *
      * @return std::unique_ptr<StateBase> nullptr if no transition, next state
      * if transition.
@@ -131,6 +170,32 @@ public:
         return nullptr;
     }
 
+    /**
+     * @brief Override to request a reqRepThreadIdleUpdate call at the
+     * returned time. std::nullopt if no timed update is needed.
+     */
+    virtual std::optional<std::chrono::steady_clock::time_point>
+      nextIdleUpdateTime() const {
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Returns the time of the next ping request, or std::nullopt if
+     * the state doesn't ping. Postponed while any instance receives replies.
+     */
+    virtual std::optional<std::chrono::steady_clock::time_point>
+      nextPingTime() const {
+        return std::max(last_ping, _heartbeat->getLastContactTime())
+               + ping_interval;
+    }
+
+    /**
+     * @brief Returns the earliest of nextIdleUpdateTime and nextPingTime,
+     * the Req/Rep thread sleeps until then unless woken earlier.
+     */
+    std::optional<std::chrono::steady_clock::time_point>
+      nextWakeupTime() const;
+
     /**
      * @brief Called from the subscriber thread when a message is received for
      * the curr object.
@@ -157,9 +222,11 @@ public:
 
     /**
      * @brief Default implementation periodically sends a ping request to ensure
-     * connection is still active. The method can be called as often as
-     * possible, time since last ping request is tracked by the StateBase
-     * object. (Called by IPCClient.)
+     * connection is still active, unless another instance received a reply
+     * recently (see Heartbeat). Pings right away if another instance lost the
+     * connection. The method can be called as often as possible, time since
+     * last ping request is tracked by the StateBase object. (Called by
+     * IPCClient.)
      */
     virtual void sendPingRequest();
 
@@ -196,24 +263,27 @@ public:
      * supported commands.
      *
      * @param reqrep_sock nng socket for states to send requests
-     * @param current_direction reference to the atomic Direction held by
-     * IPCClient, used for updating in real-time mode.
-     * @param current_distance reference to the atomic Distance held by
-     * IPCClient, used for updating in real-time mode.
+     * @param current_motion reference to the location and velocity estimate
+     * held by IPCClient, used for updating in real-time mode.
+     * @param shared_position_slot reference to the atomic slot pointer held by
+     * IPCClient, used for updating in real-time mode via shared memory.
      * @param other_plugin_state non-audio parameters of the plugin
      * @param sub_thread_ctrl for controlling the Subscriber thread managed by
      * IPCClient.
+     * @param requestor_thread_ctrl for waking the Req/Rep thread managed by
+     * IPCClient.
      * @param command_types type list of commands that this state supports
      */
     template<events::IsConcreteEvent... ReqRepCommandTypes>
     State(nng::socket_view reqrep_sock,
-          std::atomic<Direction>& current_direction,
-          std::atomic<Distance>& current_distance,
+          lock_free::SeqLock<math::MotionState>& current_motion,
+          std::atomic<const SharedPositionSlot*>& shared_position_slot,
           juce::ValueTree& other_plugin_state,
           const SubThreadController& sub_thread_ctrl,
+          const RequestorThreadController& requestor_thread_ctrl,
           utils::TypeList<ReqRepCommandTypes...> /*command_types*/)
-      : StateBase(reqrep_sock, current_direction, current_distance,
-                  other_plugin_state, std::move(sub_thread_ctrl)) {
+      : StateBase(reqrep_sock, current_motion, shared_position_slot,
+                  other_plugin_state, sub_thread_ctrl, requestor_thread_ctrl) {
         (_wanted_events.insert(ReqRepCommandTypes::id), ...);
     }
 
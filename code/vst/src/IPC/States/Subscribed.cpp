@@ -13,7 +13,7 @@ namespace ambilink::ipc::state {
 
 using SupportedCommands
   = utils::TypeList<commands::Unsubscribe, commands::EnableRenderingMode,
-                    commands::UpdateObjectList, commands::SubscribeToObject>;
+                    commands::QueryObjectList, commands::SubscribeToObject>;
 
 Subscribed::Subscribed(juce::String object_name, const Connected& prev_state)
   : State(prev_state, SupportedCommands{}) {
@@ -30,17 +30,50 @@ Subscribed::Subscribed(juce::String object_name,
 Subscribed::Subscribed(const OfflineRendering& prev_state)
   : State(prev_state, SupportedCommands{}),
     SubscribedObjectInfoHolder(prev_state) {
-    sendSimpleCommand(_reqrep_sock,
-                      constants::ReqRepCommand::INFORM_RENDER_FINISHED);
+    prev_state.leaveRenderSession(_reqrep_sock);
+    _world_oriented = _obj_info.world_oriented;
+    _shared_position_slot = _obj_info.position_slot;
 }
 
-void Subscribed::subscribe(const juce::String& object_name) {
-    auto request_data = encodeReqRepRequest(
-      constants::ReqRepCommand::OBJ_SUB,
-      encodeObjectName(utils::u8stringFromJuceString(object_name)));
-    _reqrep_sock.send(nng::view{request_data.data(), request_data.size()});
-
-    auto reply_data_reader = DataReader{_reqrep_sock.recv()};
+void Subscribed::subscribe(const juce::String& object_name,
+                           bool allow_shared_positions) {
+    _shared_position_slot = nullptr;
+    _motion_estimate_outdated = true;
+    _world_space_state_outdated = true;
+
+    const bool supports_world_space_positions
+      = _server_info.supports(constants::Capability::WORLD_SPACE_POSITIONS);
+    // Shared memory only holds camera space locations.
+    _world_oriented = supports_world_space_positions
+                      && static_cast<bool>(
+                        getOtherPluginState()[ids::world_oriented_encoding]);
+
+    juce::SharedResourcePointer<SharedPositionSegment> shared_positions{};
+    // The slot for the id received in the reply is looked up in the same
+    // mapping, unless Blender recreated the segment in the meantime.
+    const bool use_shared_positions
+      = allow_shared_positions && !_world_oriented
+        && _server_info.supports(constants::Capability::SHARED_MEMORY_POSITIONS)
+        && shared_positions->getSlot(0) != nullptr;
+    const bool use_world_space_positions
+      = !use_shared_positions && supports_world_space_positions;
+    const bool use_frame_snapshots
+      = !use_shared_positions && !use_world_space_positions
+        && _server_info.supports(constants::Capability::FRAME_SNAPSHOT);
+
+    auto request_data_writer
+      = makeReqRepRequest(constants::ReqRepCommand::OBJ_SUB);
+    writeObjectName(request_data_writer, object_name);
+    if (use_shared_positions)
+        request_data_writer.write(constants::SubFlags::SHARED_MEMORY_POSITIONS);
+    else if (use_world_space_positions)
+        request_data_writer.write(constants::SubFlags::WORLD_SPACE_POSITIONS);
+    else if (use_frame_snapshots)
+        request_data_writer.write(constants::SubFlags::FRAME_SNAPSHOTS);
+
+    auto reply_data_reader
+      = sendRequest(_reqrep_sock, getHeartbeat(),
+                    std::move(request_data_writer));
 
     auto status_code = reply_data_reader.read<constants::ReqRepStatusCode>();
 
@@ -54,11 +87,31 @@ void Subscribed::subscribe(const juce::String& object_name) {
     }
 
     _obj_info = {reply_data_reader.read<AmbilinkID>(), std::move(object_name)};
+    if (use_shared_positions) {
+        _obj_info.position_slot = shared_positions->getSlot(_obj_info.id);
+        if (!_obj_info.position_slot) {
+            // The add-on doesn't publish positions for this subscriber, so
+            // resubscribe without shared memory.
+            spdlog::warn("No shared position slot for object {}({}), "
+                         "resubscribing without shared memory.",
+                         _obj_info.name.toStdString(), _obj_info.id);
+            sendObjectUnsubRequest(
+              _reqrep_sock, getHeartbeat(), _obj_info.id,
+              constants::SubFlags::SHARED_MEMORY_POSITIONS);
+            subscribe(object_name, false);
+            return;
+        }
+    }
+    _obj_info.frame_snapshots = use_frame_snapshots;
+    _obj_info.world_space_positions = use_world_space_positions;
+    _obj_info.world_oriented = _world_oriented;
 
     queuePropUpdate(ids::object_name, _obj_info.name);
     queuePropUpdate(ids::object_deleted, false);
 
+    // The sub thread is still needed for rename and delete messages.
     _sub_thread_ctrl.start(_obj_info.id);
+    _shared_position_slot = _obj_info.position_slot;
 }
 
 std::unique_ptr<StateBase>
@@ -67,7 +120,8 @@ std::unique_ptr<StateBase>
     events::Dispatcher dispatcher(command);
     std::unique_ptr<StateBase> next_state{nullptr};
 
-    dispatchObjListUpdCommand(*this, dispatcher, _reqrep_sock);
+    dispatchObjListQueryCommand(*this, dispatcher, _reqrep_sock,
+                                getHeartbeat());
 
     dispatcher.dispatch<commands::Unsubscribe>(
       [this, &next_state](const commands::Unsubscribe&) {
@@ -78,14 +132,15 @@ std::unique_ptr<StateBase>
     dispatcher.dispatch<commands::SubscribeToObject>(
       [this](const commands::SubscribeToObject& sub_cmd) {
           _sub_thread_ctrl.stop();
-          sendObjectUnsubRequest(_reqrep_sock, _obj_info.id);
+          sendObjectUnsubRequest(_reqrep_sock, getHeartbeat(), _obj_info);
           subscribe(sub_cmd.object_name);
           return true;
       });
 
     dispatcher.dispatch<commands::EnableRenderingMode>(
-      [this, &next_state](const commands::EnableRenderingMode&) {
-          next_state = std::make_unique<OfflineRendering>(*this);
+      [this, &next_state](const commands::EnableRenderingMode& cmd) {
+          next_state
+            = std::make_unique<OfflineRendering>(cmd.start_time_secs, *this);
           return true;
       });
 
@@ -95,30 +150,67 @@ std::unique_ptr<StateBase>
 void Subscribed::onPubSubCommand(constants::PubSubMsgType msg,
                                  DataReader& reader) {
     using MsgType = constants::PubSubMsgType;
+    if (_world_space_state_outdated.exchange(false)) {
+        // Don't combine the previous object's location with the new view
+        // matrix (or vice versa) until the add-on resends both.
+        _world_location.reset();
+        _view_matrix.reset();
+    }
     switch (msg) {
         case MsgType::OBJECT_DELETED:
             _should_switch_to_deleted_state.store(true);
+            _requestor_thread_ctrl.wake();
             break;
         case MsgType::OBJECT_RENAMED:
             _obj_info.name = decodeObjectName(reader);
             queuePropUpdate(ids::object_name, _obj_info.name);
             break;
+        // The client passes snapshots positioned at this object's location.
+        // Messages published for other subscribers of the object, in a
+        // different mode than negotiated by subscribe(), are ignored.
         case MsgType::OBJECT_POSITION_UPDATED:
-            static_assert(sizeof(glm::vec3) == 3 * sizeof(float),
-                          "Ensure that glm::vec3 is just a float[3]");
-            static_assert(sizeof(float) == 4,
-                          "float must be 4 bytes for IPC to work correctly.");
-            auto&& [direction, distance]
-              = math::directionFromCamSpaceLocation(reader.read<glm::vec3>());
-
-            _curr_direction.store(direction);
-            _curr_distance.store(distance);
-            updateDirectionValTreeProp(std::move(direction),
-                                       std::move(distance));
+        case MsgType::FRAME_SNAPSHOT:
+            if (_obj_info.world_space_positions || _obj_info.position_slot)
+                break;
+            onLocationUpdated(reader.read<glm::vec3>());
+            break;
+        case MsgType::WORLD_SNAPSHOT:
+            if (!_obj_info.world_space_positions) break;
+            _world_location = reader.read<glm::vec3>();
+            onWorldSpaceUpdated();
+            break;
+        case MsgType::CAMERA_MATRIX:
+            _view_matrix = reader.read<glm::mat4>();
+            onWorldSpaceUpdated();
             break;
     }
 }
 
+void Subscribed::onWorldSpaceUpdated() {
+    static_assert(sizeof(glm::mat4) == 16 * sizeof(float));
+    if (!_world_location || !_view_matrix) return;
+    onLocationUpdated(
+      _world_oriented
+        ? math::worldToWorldOrientedLocation(*_view_matrix, *_world_location)
+        : math::worldToCamSpaceLocation(*_view_matrix, *_world_location));
+}
+
+void Subscribed::onLocationUpdated(const glm::vec3& cam_space_location) {
+    static_assert(sizeof(glm::vec3) == 3 * sizeof(float),
+                  "Ensure that glm::vec3 is just a float[3]");
+    static_assert(sizeof(float) == 4,
+                  "float must be 4 bytes for IPC to work correctly.");
+    if (_motion_estimate_outdated.exchange(false)) _motion_estimator.reset();
+    // Samples are timestamped on arrival, so the extrapolation also covers
+    // the latency between receiving them and processing audio.
+    _curr_motion.store(_motion_estimator.update(cam_space_location,
+                                                math::motionClockNowNs()));
+
+    auto&& [direction, distance]
+      = math::directionFromCamSpaceLocation(cam_space_location);
+    updateDirectionValTreeProp(std::move(direction), std::move(distance));
+}
+
 void Subscribed::updateDirectionValTreeProp(Direction&& new_direction,
                                             Distance new_distance) {
     if constexpr (val_tree_upd_interval == std::chrono::milliseconds::zero()) {
@@ -142,7 +234,21 @@ std::unique_ptr<StateBase>
     if (_should_switch_to_deleted_state) {
         return std::make_unique<ObjectDeleted>(*this);
     }
+    if (worldOrientedSettingChanged()) {
+        // Resubscribe, world oriented encoding needs world space positions.
+        _sub_thread_ctrl.stop();
+        sendObjectUnsubRequest(_reqrep_sock, getHeartbeat(), _obj_info);
+        subscribe(juce::String{_obj_info.name});
+    }
     return nullptr;
 }
 
+bool Subscribed::worldOrientedSettingChanged() {
+    if (!_server_info.supports(constants::Capability::WORLD_SPACE_POSITIONS))
+        return false;
+    return static_cast<bool>(
+             getOtherPluginState()[ids::world_oriented_encoding])
+           != _world_oriented;
+}
+
 } // namespace ambilink::ipc::state
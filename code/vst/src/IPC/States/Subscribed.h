@@ -4,6 +4,9 @@
 
 #include <IPC/Commands.h>
 
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
 #include <spdlog/spdlog.h>
 
 namespace ambilink::ipc::state {
@@ -14,7 +17,10 @@ namespace ambilink::ipc::state {
 class Subscribed : public State<Subscribed>, public SubscribedObjectInfoHolder
 {
     /// @brief subscribes to a new object, must be unsubbed when called.
-    void subscribe(const juce::String& object_name);
+    /// Shared memory positions are only requested if
+    /// `allow_shared_positions` is true.
+    void subscribe(const juce::String& object_name,
+                   bool allow_shared_positions = true);
 
     std::atomic<bool> _should_switch_to_deleted_state{false};
 
@@ -25,13 +31,39 @@ class Subscribed : public State<Subscribed>, public SubscribedObjectInfoHolder
       = std::chrono::steady_clock::now();
     void updateDirectionValTreeProp(Direction&& new_direction,
                                     Distance new_distance);
+    /// @brief updates the current location and velocity estimate from a
+    /// location received via pub/sub.
+    void onLocationUpdated(const glm::vec3& cam_space_location);
+    /// @brief only accessed by the sub thread.
+    math::MotionEstimator _motion_estimator{};
+    /// @brief set on (re)subscription, the sub thread resets
+    /// `_motion_estimator` before the next sample.
+    std::atomic<bool> _motion_estimate_outdated{false};
+
+    /// @brief value of the world oriented encoding setting at subscription,
+    /// only true if the add-on supports world space positions.
+    std::atomic<bool> _world_oriented{false};
+    /// @brief checks if the world oriented encoding setting differs from
+    /// `_world_oriented`.
+    bool worldOrientedSettingChanged();
+
+    // World space positions, only accessed by the sub thread. The add-on
+    // resends both when an object is subscribed to.
+    std::optional<glm::vec3> _world_location{};
+    std::optional<glm::mat4> _view_matrix{};
+    /// @brief set on (re)subscription, the sub thread clears `_world_location`
+    /// and `_view_matrix` before handling the next message.
+    std::atomic<bool> _world_space_state_outdated{false};
+    /// @brief updates the current direction if both the world space location
+    /// and the view matrix are known.
+    void onWorldSpaceUpdated();
 
 public:
     /// @brief subscribes to an object
     Subscribed(juce::String object_name, const Connected& prev_state);
     /// @brief stops the sub thread and subscribes to an object.
     Subscribed(juce::String object_name, const ObjectDeleted& prev_state);
-    /// @brief sends an INFORM_RENDER_FINISHED request.
+    /// @brief leaves the render session.
     Subscribed(const OfflineRendering& prev_state);
 
     std::unique_ptr<StateBase>
@@ -43,7 +75,7 @@ public:
       reqRepThreadIdleUpdate(std::function<bool()> should_stop) final;
 
     void onShutdown() final {
-        sendObjectUnsubRequest(_reqrep_sock, _obj_info.id);
+        sendObjectUnsubRequest(_reqrep_sock, getHeartbeat(), _obj_info);
         spdlog::debug("Unsubscribed from object (shutdown): {}({})",
                       _obj_info.name.toStdString(), _obj_info.id);
     }
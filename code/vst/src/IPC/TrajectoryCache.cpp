@@ -0,0 +1,36 @@
+#include "TrajectoryCache.h"
+
+namespace ambilink::ipc {
+
+TrajectoryCache::SliceData TrajectoryCache::find(const Key& key) {
+    std::lock_guard guard{_mu};
+    const auto it = _entries.find(key);
+    if (it == _entries.end()) return nullptr;
+
+    _lru.splice(_lru.begin(), _lru, it->second.lru_pos);
+    return it->second.data;
+}
+
+void TrajectoryCache::insert(const Key& key, SliceData data) {
+    if (!data) return;
+    std::lock_guard guard{_mu};
+
+    if (const auto it = _entries.find(key); it != _entries.end()) {
+        _cached_bytes -= sizeInBytes(it->second.data);
+        _lru.erase(it->second.lru_pos);
+        _entries.erase(it);
+    }
+
+    _cached_bytes += sizeInBytes(data);
+    _lru.push_front(key);
+    _entries.emplace(key, Entry{std::move(data), _lru.begin()});
+
+    while (_cached_bytes > max_cached_bytes && _lru.size() > 1) {
+        const auto it = _entries.find(_lru.back());
+        _cached_bytes -= sizeInBytes(it->second.data);
+        _entries.erase(it);
+        _lru.pop_back();
+    }
+}
+
+} // namespace ambilink::ipc
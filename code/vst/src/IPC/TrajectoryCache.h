@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <DataTypes.h>
+
+namespace ambilink::ipc {
+
+/**
+ * @brief Converted rendering data slices kept across renders, shared by all
+ * instances in the process. Use via juce::SharedResourcePointer.
+ *
+ * Slices are keyed by the animation revision reported by the Blender add-on,
+ * which changes whenever the trajectories may have changed, so rendering an
+ * unchanged scene again doesn't fetch anything. The least recently used
+ * slices are dropped when the memory limit is reached.
+ */
+class TrajectoryCache
+{
+public:
+    using SliceData = std::shared_ptr<const std::vector<DirectionWithDistance>>;
+
+    struct Key
+    {
+        AmbilinkID object_id;
+        uint64_t revision;
+        size_t slice;
+
+        auto operator<=>(const Key&) const = default;
+    };
+
+private:
+    /// @brief memory limit for cached location data.
+    constexpr static size_t max_cached_bytes = 64 * 1024 * 1024;
+
+    struct Entry
+    {
+        SliceData data;
+        std::list<Key>::iterator lru_pos;
+    };
+
+    std::mutex _mu{};
+    std::map<Key, Entry> _entries{};
+    /// @brief most recently used first.
+    std::list<Key> _lru{};
+    size_t _cached_bytes{0};
+
+    static size_t sizeInBytes(const SliceData& data) {
+        return data->size() * sizeof(DirectionWithDistance);
+    }
+
+public:
+    TrajectoryCache() = default;
+    TrajectoryCache(const TrajectoryCache&) = delete;
+    TrajectoryCache& operator=(const TrajectoryCache&) = delete;
+
+    /// @brief returns the cached slice, or nullptr if not cached.
+    SliceData find(const Key& key);
+
+    /// @brief caches a slice, replacing a previously cached one.
+    void insert(const Key& key, SliceData data);
+};
+
+} // namespace ambilink::ipc
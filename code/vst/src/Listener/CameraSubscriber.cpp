@@ -0,0 +1,113 @@
+#include "CameraSubscriber.h"
+
+#include <saf.h>
+#include <glm/matrix.hpp>
+#include <nngpp/error.h>
+#include <nngpp/protocol/req0.h>
+#include <nngpp/protocol/sub0.h>
+#include <spdlog/spdlog.h>
+
+#include <DataTypes.h>
+#include <IPC/ByteIO.h>
+#include <IPC/Constants.h>
+#include <IPC/Protocol.h>
+#include <Math/Math.h>
+
+namespace ambilink::listener {
+
+namespace {
+/// @brief maps the camera space axis convention (X right, Y up, Z forward)
+/// to the one used by SAF (X forward, Y left, Z up).
+const glm::mat3 cam_to_saf_axes{0, -1, 0, 0, 0, 1, 1, 0, 0};
+} // namespace
+
+CameraSubscriber::CameraSubscriber()
+  : _reqrep_sock(nng::req::open()), _pubsub_sock(nng::sub::open()) {
+    _rotation.store(SHRotationMatrix::identity());
+
+    _reqrep_sock.set_opt_ms(NNG_OPT_RECVTIMEO, reqrep_recv_timeout.count());
+    _reqrep_sock.set_opt_ms(NNG_OPT_SENDTIMEO, reqrep_send_timeout.count());
+    _pubsub_sock.set_opt_ms(NNG_OPT_RECVTIMEO, pubsub_recv_timeout.count());
+    const auto topic = ipc::constants::broadcast_ambilink_id;
+    _pubsub_sock.set_opt(NNG_OPT_SUB_SUBSCRIBE,
+                         nng::view{&topic, sizeof(topic)});
+
+    // Non-blocking dials keep retrying in the background until Blender
+    // starts the server.
+    _reqrep_sock.dial(ipc::constants::reqrep_addr, nng::flag::nonblock);
+    _pubsub_sock.dial(ipc::constants::pubsub_addr, nng::flag::nonblock);
+
+    _thread = std::thread{[this]() { threadFunc(); }};
+}
+
+CameraSubscriber::~CameraSubscriber() {
+    _thread_should_stop = true;
+    _thread.join();
+    // See IPCClient::~IPCClient, nng_close sometimes hangs.
+    _reqrep_sock.release();
+    _pubsub_sock.release();
+}
+
+bool CameraSubscriber::sendSubRequest() {
+    try {
+        _reqrep_sock.send(
+          ipc::makeReqRepRequest(ipc::constants::ReqRepCommand::CAMERA_SUB)
+            .release_msg());
+        ipc::DataReader reply{_reqrep_sock.recv_msg()};
+        ipc::checkReplyStatus(
+          reply.read<ipc::constants::ReqRepStatusCode>());
+        return true;
+    } catch (const nng::exception& e) {
+        spdlog::debug("CAMERA_SUB request failed: {}", e.what());
+    } catch (const ipc::exceptions::Base& e) {
+        spdlog::warn("CAMERA_SUB request failed (add-on too old?): {}",
+                     e.what());
+    }
+    return false;
+}
+
+void CameraSubscriber::onCameraMatrix(const glm::mat4& view_matrix) {
+    const glm::mat3 rotation = cam_to_saf_axes
+                               * math::cameraRotationFromViewMatrix(view_matrix)
+                               * glm::transpose(cam_to_saf_axes);
+    float rotation_xyz[3][3];
+    for (int row = 0; row < 3; row++) {
+        for (int col = 0; col < 3; col++) {
+            rotation_xyz[row][col] = rotation[col][row];
+        }
+    }
+
+    SHRotationMatrix sh_rotation{};
+    getSHrotMtxReal(rotation_xyz, sh_rotation.coeffs.data(), max_sh_order);
+    _rotation.store(sh_rotation);
+}
+
+void CameraSubscriber::threadFunc() {
+    auto next_sub_request = std::chrono::steady_clock::now();
+    while (!_thread_should_stop) {
+        if (const auto now = std::chrono::steady_clock::now();
+            now >= next_sub_request) {
+            next_sub_request = now
+                               + (sendSubRequest() ? sub_renewal_interval
+                                                   : sub_retry_interval);
+        }
+
+        try {
+            ipc::DataReader reader{_pubsub_sock.recv_msg()};
+            if (reader.read<AmbilinkID>()
+                  != ipc::constants::broadcast_ambilink_id
+                || reader.read<ipc::constants::PubSubMsgType>()
+                     != ipc::constants::PubSubMsgType::CAMERA_MATRIX)
+                continue;
+            static_assert(sizeof(glm::mat4) == 16 * sizeof(float));
+            onCameraMatrix(reader.read<glm::mat4>());
+        } catch (const nng::exception& e) {
+            if (e.get_error() != nng::error::timedout)
+                spdlog::warn("Failed to receive camera matrix: {}", e.what());
+        } catch (const std::out_of_range&) {
+            spdlog::warn("Received malformed CAMERA_MATRIX message.");
+        }
+    }
+}
+
+} // namespace ambilink::listener
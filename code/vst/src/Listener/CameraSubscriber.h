@@ -0,0 +1,67 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <nngpp/socket.h>
+#include <glm/mat4x4.hpp>
+
+#include <LockFree/SeqLock.h>
+
+#include "SHRotator.h"
+
+namespace ambilink::listener {
+
+/**
+ * @brief Receives the camera's view matrix from the Blender add-on, and
+ * provides the SH rotation matrix rotating world oriented sound fields to the
+ * camera's orientation.
+ *
+ * Runs its own thread, which renews the CAMERA_SUB lease with the add-on and
+ * receives CAMERA_MATRIX messages. The rotation matrices are calculated on
+ * that thread, the real-time thread only reads the latest one.
+ */
+class CameraSubscriber
+{
+    /// @brief interval between CAMERA_SUB requests, shorter than the lease.
+    constexpr static std::chrono::seconds sub_renewal_interval{5};
+    /// @brief interval between CAMERA_SUB requests while they fail.
+    constexpr static std::chrono::seconds sub_retry_interval{1};
+
+    constexpr static std::chrono::milliseconds reqrep_recv_timeout{1000};
+    constexpr static std::chrono::milliseconds reqrep_send_timeout{500};
+    /// @brief max time between checks of the stop flag and lease renewals.
+    constexpr static std::chrono::milliseconds pubsub_recv_timeout{100};
+
+    nng::socket _reqrep_sock;
+    nng::socket _pubsub_sock;
+
+    lock_free::SeqLock<SHRotationMatrix> _rotation{};
+
+    std::atomic<bool> _thread_should_stop{false};
+    std::thread _thread;
+
+    void threadFunc();
+
+    /// @brief sends a CAMERA_SUB request, returns false on failure.
+    bool sendSubRequest();
+
+    /// @brief calculates and stores the SH rotation for a view matrix.
+    void onCameraMatrix(const glm::mat4& view_matrix);
+
+public:
+    CameraSubscriber();
+    ~CameraSubscriber();
+    CameraSubscriber(const CameraSubscriber&) = delete;
+    CameraSubscriber& operator=(const CameraSubscriber&) = delete;
+
+    /**
+     * @brief The latest SH rotation matrix, identity until the first
+     * CAMERA_MATRIX message is received. Real-time safe.
+     */
+    const lock_free::SeqLock<SHRotationMatrix>& getRotation() const {
+        return _rotation;
+    }
+};
+
+} // namespace ambilink::listener
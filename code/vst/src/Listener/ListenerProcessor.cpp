@@ -0,0 +1,69 @@
+#include "ListenerProcessor.h"
+
+#include <cmath>
+
+namespace {
+/// @brief returns the SH order for the channel count, or 0 if it doesn't
+/// match an order supported by the listener.
+uint8_t shOrderFromChannelCount(int channel_count) {
+    using namespace ambilink::listener;
+    const auto order = static_cast<int>(std::sqrt(channel_count)) - 1;
+    if (order < 1 || order > max_sh_order
+        || (order + 1) * (order + 1) != channel_count)
+        return 0;
+    return static_cast<uint8_t>(order);
+}
+} // namespace
+
+namespace ambilink::listener {
+
+AudioProcessor::AudioProcessor()
+  : juce::AudioProcessor(
+    BusesProperties()
+      .withInput("Ambisonics Input (up to 5th order)",
+                 juce::AudioChannelSet::ambisonic(max_sh_order), true)
+      .withOutput("Ambisonics Output (up to 5th order)",
+                  juce::AudioChannelSet::ambisonic(max_sh_order), true)) {}
+
+AudioProcessor::~AudioProcessor() = default;
+
+void AudioProcessor::prepareToPlay(double /*sample_rate*/,
+                                   int max_expected_samples_per_block) {
+    _rotator.prepare(max_expected_samples_per_block);
+    _rotation_version = 0;
+}
+
+void AudioProcessor::releaseResources() {}
+
+bool AudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const {
+    return layouts.getMainInputChannels() == layouts.getMainOutputChannels()
+           && shOrderFromChannelCount(layouts.getMainOutputChannels()) != 0;
+}
+
+void AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
+                                  juce::MidiBuffer& /*midiMessages*/) {
+    juce::ScopedNoDenormals noDenormals;
+
+    const auto sh_order = shOrderFromChannelCount(buffer.getNumChannels());
+    if (sh_order == 0) return;
+
+    // Encoders use camera space rendering data when rendering offline, which
+    // is already rotated.
+    if (isNonRealtime()) {
+        _rotator.setMatrix(SHRotationMatrix::identity());
+        _rotation_version = 0;
+    } else if (const auto& rotation = _camera_subscriber.getRotation();
+               rotation.version() != _rotation_version) {
+        const auto snapshot = rotation.read();
+        _rotator.setMatrix(snapshot.value);
+        _rotation_version = snapshot.version;
+    }
+    _rotator.process(buffer, sh_order);
+}
+
+} // namespace ambilink::listener
+
+/// @brief creates new instances of the plugin
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter() {
+    return new ambilink::listener::AudioProcessor();
+}
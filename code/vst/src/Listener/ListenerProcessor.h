@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+#include "CameraSubscriber.h"
+#include "SHRotator.h"
+
+/**
+ * @brief The Ambilink Listener plugin, which rotates the ambisonic mix of
+ * world oriented encoder instances to the camera's orientation.
+ */
+namespace ambilink::listener {
+
+/**
+ * @brief Rotates the ambisonic bus it's inserted on by the camera's rotation.
+ * Meant for the master bus, so camera rotations are handled by a single
+ * matrix instead of updating the direction of each encoder instance.
+ */
+class AudioProcessor : public juce::AudioProcessor
+{
+public:
+    AudioProcessor();
+    ~AudioProcessor() override;
+
+    ////////////////////////////
+    ///// audio processing /////
+    ////////////////////////////
+
+    void prepareToPlay(double sample_rate,
+                       int max_expected_samples_per_block) final;
+    void releaseResources() final;
+
+    bool isBusesLayoutSupported(const BusesLayout& layouts) const final;
+
+    void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) final;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) final {
+        // Unsupported, just to silence warning.
+    }
+
+    //////////////////////
+    ///// gui editor /////
+    //////////////////////
+
+    juce::AudioProcessorEditor* createEditor() final { return nullptr; }
+    bool hasEditor() const final { return false; }
+
+    ///////////////////////
+    ///// plugin info /////
+    ///////////////////////
+
+    const juce::String getName() const final { return JucePlugin_Name; }
+
+    bool acceptsMidi() const final { return false; }
+    bool producesMidi() const final { return false; }
+    bool isMidiEffect() const final { return false; }
+    double getTailLengthSeconds() const final { return 0.0; }
+
+    ///////////////////////////////////////////////////
+    ///// plugin programs (presets) - unsupported /////
+    ///////////////////////////////////////////////////
+
+    int getNumPrograms() final { return 1; }
+    int getCurrentProgram() final { return 0; }
+    void setCurrentProgram(int /*index*/) final {}
+    const juce::String getProgramName(int /*index*/) final { return {}; }
+    void changeProgramName(int /*index*/,
+                           const juce::String& /*new_name*/) final {}
+
+    ///////////////////////////////
+    ///// state serialisation /////
+    ///////////////////////////////
+
+    // No state besides the connection to Blender.
+    void getStateInformation(juce::MemoryBlock& /*dest_data*/) final {}
+    void setStateInformation(const void* /*data*/,
+                             int /*size_in_bytes*/) final {}
+
+private:
+    CameraSubscriber _camera_subscriber{};
+    SHRotator _rotator{};
+    /// @brief version of the last rotation passed to `_rotator`.
+    uint32_t _rotation_version{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioProcessor)
+};
+
+} // namespace ambilink::listener
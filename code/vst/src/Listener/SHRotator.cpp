@@ -0,0 +1,94 @@
+#include "SHRotator.h"
+
+#include <algorithm>
+
+namespace ambilink::listener {
+
+SHRotationMatrix SHRotationMatrix::identity() {
+    SHRotationMatrix matrix{};
+    for (uint16_t i = 0; i < max_sh_signals; i++) {
+        matrix.coeffs[i * max_sh_signals + i] = 1.0f;
+    }
+    return matrix;
+}
+
+void SHRotator::prepare(int max_block_size) {
+    _input_copy.setSize(max_sh_signals, max_block_size);
+    _tmp_prev.resize(max_block_size);
+    _tmp_curr.resize(max_block_size);
+    _interpolator_fade_in.resize(max_block_size);
+    _interpolator_fade_out.resize(max_block_size);
+    _prev_interpolator_frame_size = 0;
+}
+
+void SHRotator::recalcInterpolatorBuffers(int frame_size) {
+    if (_prev_interpolator_frame_size == frame_size) return;
+    _prev_interpolator_frame_size = frame_size;
+
+    for (int sample = 0; sample < frame_size; sample++) {
+        _interpolator_fade_in[sample]
+          = static_cast<float>(sample + 1) / static_cast<float>(frame_size);
+        _interpolator_fade_out[sample] = 1.0f - _interpolator_fade_in[sample];
+    }
+}
+
+void SHRotator::rotateChannel(const SHRotationMatrix& matrix, int out_ch,
+                              int order, int frame_size, float* out) const {
+    const int first_ch = order * order;
+    const int last_ch = first_ch + 2 * order;
+    juce::FloatVectorOperations::clear(out, frame_size);
+    for (int in_ch = first_ch; in_ch <= last_ch; in_ch++) {
+        const float coeff = matrix.at(out_ch, in_ch);
+        if (coeff == 0.0f) continue;
+        juce::FloatVectorOperations::addWithMultiply(
+          out, _input_copy.getReadPointer(in_ch), coeff, frame_size);
+    }
+}
+
+void SHRotator::processFrame(juce::AudioBuffer<float>& buffer,
+                             int start_sample, int frame_size,
+                             uint8_t sh_order) {
+    const int num_sh_signals = (sh_order + 1) * (sh_order + 1);
+    for (int ch = 0; ch < num_sh_signals; ch++) {
+        _input_copy.copyFrom(ch, 0, buffer, ch, start_sample, frame_size);
+    }
+
+    const bool interpolate = _prev_matrix != _curr_matrix;
+    if (interpolate) recalcInterpolatorBuffers(frame_size);
+
+    // The omnidirectional channel is never affected by rotation.
+    for (int order = 1; order <= sh_order; order++) {
+        for (int ch = order * order; ch <= order * order + 2 * order; ch++) {
+            float* out = buffer.getWritePointer(ch, start_sample);
+            if (!interpolate) {
+                rotateChannel(_curr_matrix, ch, order, frame_size, out);
+                continue;
+            }
+            rotateChannel(_prev_matrix, ch, order, frame_size,
+                          _tmp_prev.data());
+            rotateChannel(_curr_matrix, ch, order, frame_size,
+                          _tmp_curr.data());
+            juce::FloatVectorOperations::multiply(
+              out, _tmp_prev.data(), _interpolator_fade_out.data(),
+              frame_size);
+            juce::FloatVectorOperations::addWithMultiply(
+              out, _tmp_curr.data(), _interpolator_fade_in.data(), frame_size);
+        }
+    }
+    _prev_matrix = _curr_matrix;
+}
+
+void SHRotator::process(juce::AudioBuffer<float>& buffer, uint8_t sh_order) {
+    const int max_frame_size = _input_copy.getNumSamples();
+    if (max_frame_size == 0) return;
+
+    // Hosts may exceed the block size passed to prepareToPlay.
+    for (int start = 0; start < buffer.getNumSamples();
+         start += max_frame_size) {
+        processFrame(buffer, start,
+                     std::min(max_frame_size, buffer.getNumSamples() - start),
+                     sh_order);
+    }
+}
+
+} // namespace ambilink::listener
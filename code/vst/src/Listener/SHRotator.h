@@ -0,0 +1,79 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+namespace ambilink::listener {
+
+/// @brief max order of the rotated sound field, same as for the encoder.
+constexpr uint8_t max_sh_order = 5;
+constexpr uint16_t max_sh_signals = (max_sh_order + 1) * (max_sh_order + 1);
+
+/**
+ * @brief Real SH rotation matrix for `max_sh_order` (ACN channel ordering),
+ * row-major. Matrices of lower orders are its top left submatrices.
+ */
+struct SHRotationMatrix
+{
+    std::array<float, max_sh_signals * max_sh_signals> coeffs{};
+
+    static SHRotationMatrix identity();
+
+    float at(uint16_t row, uint16_t col) const {
+        return coeffs[row * max_sh_signals + col];
+    }
+
+    bool operator==(const SHRotationMatrix&) const = default;
+};
+
+/**
+ * @brief Rotates an ambisonic sound field. When the matrix changes, the
+ * output is crossfaded from the previous rotation to the new one over a
+ * single block.
+ *
+ * The matrix is block diagonal (SH orders don't mix), so each output channel
+ * only depends on the `2l+1` input channels of its order.
+ */
+class SHRotator
+{
+    SHRotationMatrix _prev_matrix{SHRotationMatrix::identity()};
+    SHRotationMatrix _curr_matrix{SHRotationMatrix::identity()};
+
+    /* Internal audio buffers, allocated in `prepare` */
+    juce::AudioBuffer<float> _input_copy{};
+    std::vector<float> _tmp_prev{};
+    std::vector<float> _tmp_curr{};
+    std::vector<float> _interpolator_fade_in{};
+    std::vector<float> _interpolator_fade_out{};
+    int _prev_interpolator_frame_size{0};
+
+    /// @brief calculates interpolator buffers for the given frame size.
+    void recalcInterpolatorBuffers(int frame_size);
+
+    /// @brief writes the rotated input channel range of order `order` to
+    /// `out`, for output channel `out_ch`.
+    void rotateChannel(const SHRotationMatrix& matrix, int out_ch, int order,
+                       int frame_size, float* out) const;
+
+    /// @brief rotates a part of the buffer no longer than the size passed
+    /// to `prepare`.
+    void processFrame(juce::AudioBuffer<float>& buffer, int start_sample,
+                      int frame_size, uint8_t sh_order);
+
+public:
+    /// @brief allocates buffers for blocks of up to `max_block_size` samples.
+    void prepare(int max_block_size);
+
+    /// @brief sets the rotation used from the next `process` call on.
+    void setMatrix(const SHRotationMatrix& matrix) { _curr_matrix = matrix; }
+
+    /**
+     * @brief Rotates the first `shSignalCount(sh_order)` channels of the
+     * buffer in place.
+     */
+    void process(juce::AudioBuffer<float>& buffer, uint8_t sh_order);
+};
+
+} // namespace ambilink::listener
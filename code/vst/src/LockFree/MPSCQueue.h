@@ -0,0 +1,140 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include <Utility/Utils.h>
+
+/**
+ * @brief Data structures for real-time thread use.
+ */
+namespace ambilink::lock_free {
+
+/// @brief assumed cache line size, used to avoid false sharing.
+inline constexpr size_t cache_line_size = 64;
+
+/**
+ * @brief A fixed-size lock-free FIFO queue that can be pushed to from any
+ * number of threads and is consumed by a single thread.
+ *
+ * Each cell carries a sequence number telling producers whether it is free
+ * and the consumer whether it has been published, so producers only contend
+ * on the write position (a single CAS per push) and never wait for each
+ * other.
+ *
+ * @tparam ItemT type of items stored in the queue.
+ * @tparam MaxQueueSize min number of items that can be queued, rounded up to
+ * a power of two.
+ */
+template<typename ItemT, size_t MaxQueueSize>
+    requires(MaxQueueSize > 0
+             && MaxQueueSize < std::numeric_limits<uint16_t>::max()
+             && std::is_default_constructible_v<ItemT>)
+class MPSCQueue
+{
+    constexpr static size_t capacity = std::bit_ceil(MaxQueueSize);
+    constexpr static uint32_t index_mask = capacity - 1;
+
+    struct Cell
+    {
+        /// @brief == position: free for the producer writing at position,
+        /// == position + 1: published for the consumer reading at position.
+        std::atomic<uint32_t> seq;
+        ItemT item;
+    };
+
+    alignas(cache_line_size) std::atomic<uint32_t> _write_pos{0};
+    /// @brief only accessed by the consumer.
+    alignas(cache_line_size) uint32_t _read_pos{0};
+    alignas(cache_line_size) std::array<Cell, capacity> _cells;
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+    Cell& cellAt(uint32_t pos) { return _cells[pos & index_mask]; }
+
+public:
+    MPSCQueue() {
+        for (uint32_t i = 0; i < capacity; i++) {
+            _cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    /**
+     * @brief Push an item to the queue, never blocks. Safe to call from
+     * multiple threads concurrently.
+     *
+     * @param item the item to push. Left untouched if the queue is full.
+     * @return true The queue was not full, item pushed.
+     * @return false The queue was full.
+     */
+    bool pushOrFail(ItemT&& item) {
+        auto pos = _write_pos.load(std::memory_order_relaxed);
+        while (true) {
+            auto& cell = cellAt(pos);
+            const auto seq = cell.seq.load(std::memory_order_acquire);
+            const auto diff
+              = static_cast<int32_t>(seq) - static_cast<int32_t>(pos);
+            if (diff == 0) {
+                if (_write_pos.compare_exchange_weak(
+                      pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.item = std::move(item);
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                // The consumer hasn't freed this cell yet.
+                return false;
+            } else {
+                // Another producer claimed this position.
+                pos = _write_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Checks if the next item is available. Must be called by the
+     * consumer. An item that is still being pushed counts as not available.
+     */
+    bool empty() {
+        return cellAt(_read_pos).seq.load(std::memory_order_acquire)
+               != _read_pos + 1;
+    }
+
+    /**
+     * @brief Get the oldest item from the queue. Must be called by the
+     * consumer, and the queue must not be empty.
+     */
+    ItemT pop() {
+        auto& cell = cellAt(_read_pos);
+        assert(!empty());
+
+        utils::OnScopeExit free_cell{[this, &cell]() {
+            cell.seq.store(_read_pos + capacity, std::memory_order_release);
+            _read_pos++;
+        }};
+        return std::move(cell.item);
+    }
+
+    /**
+     * @brief Pops up to `max_count` items, passing each to `consume`. Must be
+     * called by the consumer.
+     *
+     * @return the number of items consumed.
+     */
+    template<typename ConsumeFunc>
+    size_t drain(ConsumeFunc&& consume,
+                 size_t max_count = std::numeric_limits<size_t>::max()) {
+        size_t count = 0;
+        for (; count < max_count && !empty(); count++) {
+            consume(pop());
+        }
+        return count;
+    }
+};
+} // namespace ambilink::lock_free
@@ -0,0 +1,118 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace ambilink::lock_free {
+
+/**
+ * @brief Holds a small trivially copyable value which is written by
+ * non-real-time threads and read by the real-time thread as one consistent
+ * snapshot, without locks.
+ *
+ * The value is stored as relaxed atomic words guarded by a sequence counter,
+ * which is odd while a write is in progress. Readers retry until they observe
+ * the same even counter before and after copying the value. Writers are
+ * serialised among themselves by briefly spinning on the counter, so multiple
+ * writer threads are allowed, but writes should be short and rare compared to
+ * reads.
+ *
+ * @tparam T type of the stored value.
+ */
+template<typename T>
+    requires(std::is_trivially_copyable_v<T>
+             && std::is_default_constructible_v<T>)
+class SeqLock
+{
+    constexpr static size_t word_count
+      = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    using Words = std::array<uint32_t, word_count>;
+
+    std::atomic<uint32_t> _seq{0};
+    std::array<std::atomic<uint32_t>, word_count> _words{};
+    static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+    static Words toWords(const T& value) {
+        Words words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+        return words;
+    }
+
+public:
+    /// @brief A value together with the version it was stored under.
+    struct Snapshot
+    {
+        T value;
+        /// @brief changes with every store, never 0 after the first store.
+        uint32_t version;
+    };
+
+    SeqLock() { store(T{}); }
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    /**
+     * @brief Replaces the stored value. Not real-time safe if called from
+     * multiple threads concurrently (spins while another write is in
+     * progress).
+     */
+    void store(const T& value) {
+        auto seq = _seq.load(std::memory_order_relaxed);
+        while ((seq & 1)
+               || !_seq.compare_exchange_weak(seq, seq + 1,
+                                              std::memory_order_acquire,
+                                              std::memory_order_relaxed)) {
+            if (seq & 1) {
+                std::this_thread::yield();
+                seq = _seq.load(std::memory_order_relaxed);
+            }
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+
+        const auto words = toWords(value);
+        for (size_t i = 0; i < word_count; i++) {
+            _words[i].store(words[i], std::memory_order_relaxed);
+        }
+        _seq.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Returns a consistent copy of the stored value and its version.
+     * Never blocks, but retries if a write overlaps with the read.
+     */
+    Snapshot read() const {
+        while (true) {
+            const auto seq_before = _seq.load(std::memory_order_acquire);
+            if (seq_before & 1) continue;
+
+            Words words;
+            for (size_t i = 0; i < word_count; i++) {
+                words[i] = _words[i].load(std::memory_order_relaxed);
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_seq.load(std::memory_order_relaxed) != seq_before) continue;
+
+            Snapshot snapshot{};
+            std::memcpy(&snapshot.value, words.data(), sizeof(T));
+            snapshot.version = seq_before / 2;
+            return snapshot;
+        }
+    }
+
+    /// @brief Returns a consistent copy of the stored value.
+    T load() const { return read().value; }
+
+    /**
+     * @brief Returns the version of the stored value, can be used to cheaply
+     * check whether it has changed since the last read.
+     */
+    uint32_t version() const {
+        return _seq.load(std::memory_order_acquire) / 2;
+    }
+};
+
+} // namespace ambilink::lock_free
@@ -0,0 +1,92 @@
+#include "DeadReckoning.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+namespace {
+constexpr float nsToSecs(int64_t ns) { return static_cast<float>(ns) * 1e-9f; }
+} // namespace
+
+namespace ambilink::math {
+
+int64_t motionClockNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+glm::vec3 MotionState::extrapolate(int64_t time_ns) const {
+    const auto max_secs
+      = std::min(max_extrapolation_secs, sample_interval_secs);
+    const auto elapsed_secs = std::max(0.0f, nsToSecs(time_ns - timestamp_ns));
+    // Without a new sample by then the object has likely stopped (the add-on
+    // only republishes unchanged locations after its max publish interval),
+    // ease back to the last sample.
+    const auto secs = elapsed_secs <= max_secs
+                        ? elapsed_secs
+                        : std::max(0.0f, 2 * max_secs - elapsed_secs);
+
+    auto displacement = velocity * secs;
+    const auto max_displacement
+      = max_displacement_ratio * glm::length(location);
+    if (const auto length = glm::length(displacement);
+        length > max_displacement && length > 0) {
+        displacement *= max_displacement / length;
+    }
+    return location + displacement;
+}
+
+const MotionState& MotionEstimator::update(const glm::vec3& location,
+                                           int64_t timestamp_ns) {
+    const auto interval_secs = nsToSecs(timestamp_ns - _state.timestamp_ns);
+    if (!_state.hasSample() || interval_secs <= 0
+        || interval_secs > max_sample_interval_secs) {
+        _state = {location, glm::vec3{0}, timestamp_ns, 0};
+        return _state;
+    }
+
+    // Unchanged samples (keepalives, shared memory rewrites of a static
+    // object) mean the object has stopped, smoothing would keep half of the
+    // residual velocity and extrapolate away from the sample again.
+    if (location == _state.location) {
+        _state.velocity = glm::vec3{0};
+    } else {
+        const auto sample_velocity
+          = (location - _state.location) / interval_secs;
+        _state.velocity
+          = glm::mix(_state.velocity, sample_velocity, velocity_smoothing);
+    }
+    _state.location = location;
+    _state.timestamp_ns = timestamp_ns;
+    _state.sample_interval_secs = interval_secs;
+    return _state;
+}
+
+void SmoothedExtrapolation::setState(const MotionState& state,
+                                     int64_t time_ns) {
+    if (!state.hasSample()) {
+        _last_output = std::nullopt;
+    } else if (_last_output) {
+        _correction = *_last_output - state.extrapolate(time_ns);
+        _correction_start_ns = time_ns;
+    } else {
+        _correction = glm::vec3{0};
+    }
+    _state = state;
+}
+
+std::optional<glm::vec3> SmoothedExtrapolation::locationAt(int64_t time_ns) {
+    if (!_state.hasSample()) return std::nullopt;
+
+    const auto decay
+      = std::exp(-std::max(0.0f, nsToSecs(time_ns - _correction_start_ns))
+                 / correction_time_constant_secs);
+    _last_output = _state.extrapolate(time_ns) + _correction * decay;
+    return _last_output;
+}
+
+} // namespace ambilink::math
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "glm/vec3.hpp"
+
+namespace ambilink::math {
+
+/// @brief current time of the clock used for motion timestamps (unix time, the
+/// same clock as the Blender add-on's shared memory timestamps), in
+/// nanoseconds.
+int64_t motionClockNowNs();
+
+/**
+ * @brief Camera space location of an object at a point in time, with a
+ * velocity estimate allowing to extrapolate the location shortly past it.
+ */
+struct MotionState
+{
+    /// @brief max time the location is extrapolated past `timestamp_ns`.
+    constexpr static float max_extrapolation_secs = 0.1f;
+    /// @brief max extrapolated displacement, relative to the distance from
+    /// the camera. Limits direction errors if the estimate is off, e.g. after
+    /// an object was moved in a single step.
+    constexpr static float max_displacement_ratio = 0.25f;
+
+    glm::vec3 location{0};
+    /// @brief units per second.
+    glm::vec3 velocity{0};
+    /// @brief time of the sample, see motionClockNowNs. 0 if there is no
+    /// sample.
+    int64_t timestamp_ns{0};
+    /// @brief time since the previous sample, extrapolating further than that
+    /// would guess past the next update.
+    float sample_interval_secs{0};
+
+    bool hasSample() const { return timestamp_ns != 0; }
+
+    /// @brief the location extrapolated to `time_ns`, with the extrapolation
+    /// time and displacement clamped. Eases back to `location` over the same
+    /// time if no new sample replaces the state by then.
+    glm::vec3 extrapolate(int64_t time_ns) const;
+};
+
+/**
+ * @brief Estimates the velocity of an object from successive location
+ * samples. Not thread safe.
+ */
+class MotionEstimator
+{
+    /// @brief samples further apart than this don't give a usable velocity,
+    /// the object is assumed to be static.
+    constexpr static float max_sample_interval_secs = 1.0f;
+    /// @brief weight of the newest sample's velocity in the estimate.
+    constexpr static float velocity_smoothing = 0.5f;
+
+    MotionState _state{};
+
+public:
+    /// @brief adds a sample, returns the updated state. A sample at the
+    /// previous location resets the velocity.
+    const MotionState& update(const glm::vec3& location, int64_t timestamp_ns);
+    void reset() { _state = {}; }
+};
+
+/**
+ * @brief Extrapolates a MotionState, and smooths out the jump when it is
+ * replaced by a state based on a new sample: the difference to the previous
+ * output decays exponentially instead of being applied at once. Not thread
+ * safe, meant to be used by the real-time thread.
+ */
+class SmoothedExtrapolation
+{
+    /// @brief time constant of the correction decay.
+    constexpr static float correction_time_constant_secs = 0.02f;
+
+    MotionState _state{};
+    std::optional<glm::vec3> _last_output{};
+    glm::vec3 _correction{0};
+    int64_t _correction_start_ns{0};
+
+public:
+    /// @brief replaces the extrapolated state, a state without a sample
+    /// resets the smoothing.
+    void setState(const MotionState& state, int64_t time_ns);
+
+    /// @brief the smoothed location at `time_ns`, std::nullopt if there is
+    /// no sample.
+    std::optional<glm::vec3> locationAt(int64_t time_ns);
+};
+
+} // namespace ambilink::math
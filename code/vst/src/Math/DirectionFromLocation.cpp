@@ -1,7 +1,9 @@
 #include "./Math.h"
 #include <glm/vec3.hpp>
 #include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
 
+#include <glm/matrix.hpp>
 #include <glm/trigonometric.hpp>
 #include <glm/gtx/compatibility.hpp>
 
@@ -22,4 +24,25 @@ DirectionWithDistance
                       glm::degrees(static_cast<float>(elevation))},
             glm::length(location_camera_space)};
 }
+
+glm::vec3 worldToCamSpaceLocation(const glm::mat4& view_matrix,
+                                  const glm::vec3& location_world_space) {
+    return glm::vec3{view_matrix * glm::vec4{location_world_space, 1.0f}};
+}
+
+namespace {
+/// @brief swaps the Y and Z axes, maps world space axes to the camera space
+/// convention and back.
+const glm::mat3 world_to_cam_axes{1, 0, 0, 0, 0, 1, 0, 1, 0};
+} // namespace
+
+glm::vec3 worldToWorldOrientedLocation(const glm::mat4& view_matrix,
+                                       const glm::vec3& location_world_space) {
+    const glm::vec3 camera_location{glm::inverse(view_matrix)[3]};
+    return world_to_cam_axes * (location_world_space - camera_location);
+}
+
+glm::mat3 cameraRotationFromViewMatrix(const glm::mat4& view_matrix) {
+    return glm::mat3{view_matrix} * world_to_cam_axes;
+}
 } // namespace ambilink::math
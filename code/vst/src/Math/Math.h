@@ -4,6 +4,8 @@
 #include <utility>
 
 #include "glm/vec3.hpp"
+#include "glm/mat3x3.hpp"
+#include "glm/mat4x4.hpp"
 #include "../DataTypes.h"
 
 /// @brief Math utility functions.
@@ -16,4 +18,26 @@ namespace ambilink::math {
 DirectionWithDistance
   directionFromCamSpaceLocation(const glm::vec3& location_camera_space);
 
+/**
+ * @brief Transforms a world space location to camera space (Z-axis points
+ * forward) using the view matrix published by the Blender add-on.
+ */
+glm::vec3 worldToCamSpaceLocation(const glm::mat4& view_matrix,
+                                  const glm::vec3& location_world_space);
+
+/**
+ * @brief Calculates the location of an object relative to the camera, in a
+ * frame with world space orientation and the camera space axis convention
+ * (X: world X, Y: world Z (up), Z: world Y). Doesn't change when the camera
+ * only rotates.
+ */
+glm::vec3 worldToWorldOrientedLocation(const glm::mat4& view_matrix,
+                                       const glm::vec3& location_world_space);
+
+/**
+ * @brief Calculates the rotation transforming world oriented locations (see
+ * worldToWorldOrientedLocation) to camera space.
+ */
+glm::mat3 cameraRotationFromViewMatrix(const glm::mat4& view_matrix);
+
 } // namespace ambilink::math
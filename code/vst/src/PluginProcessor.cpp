@@ -59,20 +59,33 @@ AudioProcessor::~AudioProcessor() = default;
 
 void AudioProcessor::prepareToPlay(double /*sample_rate*/,
                                    int /*maxExpectedSamplesPerBlock*/) {
+    // State transitions happen asynchronously, so that all instances can
+    // transition in parallel. processBlock waits for the transition to
+    // OfflineRendering (which includes fetching the first rendering data).
+    _rendering_mode_requested = isNonRealtime();
+    _rendering_mode_sent = false;
     if (_ipc_client.isInState<ipc::state::Subscribed>() && isNonRealtime()) {
-        sendEvent(ipc::commands::EnableRenderingMode{});
-        while (_ipc_client.isInState<ipc::state::Subscribed>()) {
-            std::this_thread::sleep_for(std::chrono::milliseconds{10});
-        }
+        sendEnableRenderingMode();
     } else if (_ipc_client.isInState<ipc::state::OfflineRendering>()
                && !isNonRealtime()) {
         sendEvent(ipc::commands::DisableRenderingMode{});
-        while (_ipc_client.isInState<ipc::state::OfflineRendering>()) {
-            std::this_thread::sleep_for(std::chrono::milliseconds{10});
-        }
     }
 }
 
+void AudioProcessor::sendEnableRenderingMode() {
+    // Not all hosts report the position outside of processBlock, data for
+    // other positions is fetched on demand.
+    float start_time_secs = 0;
+    juce::AudioPlayHead::CurrentPositionInfo position{};
+    if (auto* play_head = getPlayHead();
+        play_head && play_head->getCurrentPosition(position)) {
+        start_time_secs
+          = static_cast<float>(std::max(0.0, position.timeInSeconds));
+    }
+    _rendering_mode_sent = true;
+    sendEvent(ipc::commands::EnableRenderingMode{start_time_secs});
+}
+
 void AudioProcessor::releaseResources() {}
 
 void AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
@@ -82,18 +95,44 @@ void AudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     // TODO: allow user to use downmix or just the first channel - potential
     // phase issues
     utils::audio::downmixToMono(buffer);
-    if (_ipc_client.isInState<ipc::state::OfflineRendering>()) {
+    if (_rendering_mode_requested
+        && _ipc_client.isInState<ipc::state::Subscribed,
+                                 ipc::state::OfflineRendering>()) {
         processInRenderingMode(buffer);
     } else {
-        // In states other than subscribed this just returns `Direction{0, 0},
-        // and Distance{0}`
-        _encoder.updateDirAndDistance(_ipc_client.getCurrentDirection_rt(),
-                                      _ipc_client.getCurrentDistance_rt());
-        _encoder.process(buffer);
+        processBlockRealtime(buffer);
     }
 }
 
+void AudioProcessor::processBlockRealtime(juce::AudioBuffer<float>& buffer) {
+    // In states other than subscribed this just returns `Direction{0, 0},
+    // and Distance{0}`
+    _encoder.updateDirAndDistance(
+      _ipc_client.getCurrentDirectionAndDistance_rt());
+    _encoder.process(buffer);
+}
+
 void AudioProcessor::processInRenderingMode(juce::AudioBuffer<float>& buffer) {
+    if (_ipc_client.isInState<ipc::state::Subscribed>()) {
+        // The client may have reached Subscribed only after prepareToPlay,
+        // e.g. while restoring the subscription of a project being exported.
+        if (!_rendering_mode_sent) sendEnableRenderingMode();
+
+        // Wait for the transition, blocking is fine since rendering isn't
+        // real-time.
+        const auto wait_start = std::chrono::steady_clock::now();
+        while (_ipc_client.isInState<ipc::state::Subscribed>()
+               && std::chrono::steady_clock::now() - wait_start
+                    < max_rendering_mode_wait) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+        if (_ipc_client.isInState<ipc::state::Subscribed>()) {
+            // Only wait once, the following blocks use the real-time path.
+            _rendering_mode_requested = false;
+            return processBlockRealtime(buffer);
+        }
+    }
+
     juce::AudioPlayHead::CurrentPositionInfo position{};
     if (!getPlayHead()->getCurrentPosition(position)) {
         jassertfalse;
@@ -152,7 +191,8 @@ void AudioProcessor::setStateInformation(const void* data, int sizeInBytes) {
       = juce::ValueTree::readFromData(data, static_cast<size_t>(sizeInBytes));
 
     for (auto id : ids::serialized_non_params) {
-        jassert(deserialized_combined_state.hasProperty(id));
+        // States saved by older versions don't have all properties.
+        if (!deserialized_combined_state.hasProperty(id)) continue;
         _other_state.setProperty(id, deserialized_combined_state[id], nullptr);
         deserialized_combined_state.removeProperty(id, nullptr);
     }
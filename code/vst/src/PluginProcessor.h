@@ -1,4 +1,6 @@
 #pragma once
+#include <atomic>
+#include <chrono>
 
 #include <juce_audio_processors/juce_audio_processors.h>
 
@@ -93,6 +95,22 @@ private:
     ambilink::ipc::IPCClient _ipc_client;
     ambilink::encoders::BasicEncoder _encoder;
 
+    /// @brief set in prepareToPlay if the host is rendering offline, cleared
+    /// if the transition to OfflineRendering times out.
+    std::atomic<bool> _rendering_mode_requested{false};
+    /// @brief whether EnableRenderingMode has been sent since prepareToPlay.
+    std::atomic<bool> _rendering_mode_sent{false};
+    /// @brief max time the first rendering block waits for the IPC client to
+    /// transition to OfflineRendering before falling back to the real-time
+    /// path.
+    constexpr static std::chrono::seconds max_rendering_mode_wait{10};
+
+    /// @brief sends EnableRenderingMode starting at the play head position.
+    void sendEnableRenderingMode();
+
+    /// @brief encodes with the direction and distance received in real-time.
+    void processBlockRealtime(juce::AudioBuffer<float>& buffer);
+
     /**
      * @brief Used to process audio in offline rendering mode.
      * Gets data directly from the ipc::state::OfflineRendering instance
@@ -56,6 +56,20 @@ public:
         _buffer.copyFrom(dest_channel, _start_sample + dest_start_sample,
                          source, num_samples);
     }
+    void copyFrom(int dest_channel, int dest_start_sample, const T* source,
+                  int num_samples, T gain) {
+        _buffer.copyFrom(dest_channel, _start_sample + dest_start_sample,
+                         source, num_samples, gain);
+    }
+
+    /**
+     * @brief Multiplies all samples of a channel (only the samples this view
+     * is referencing) by `gain`.
+     */
+    void applyGain(int channel, T gain) {
+        _buffer.applyGain(channel, _start_sample, _num_samples, gain);
+    }
+
     const T* getReadPointer(int channelNumber) {
         return _buffer.getReadPointer(channelNumber) + _start_sample;
     }
@@ -23,18 +23,23 @@ declare_juce_id(ambilink_other_state);
 
 declare_juce_id(object_name);
 declare_juce_id(object_deleted);
+/// @brief if true, directions are relative to the camera location, but not
+/// its rotation, which is applied to the whole mix by the listener plugin.
+declare_juce_id(world_oriented_encoding);
 
 declare_juce_id(ipc_client_state);
 declare_juce_id(curr_direction_azimuth_deg);
 declare_juce_id(curr_direction_elevation_deg);
 declare_juce_id(curr_distance);
-declare_juce_id(object_list);
+/// @brief holds the last ipc::ObjectListPage received.
+declare_juce_id(object_list_page);
 
 /// @brief Value with this ID will be set if an exception
 /// occurs during IPC communication.
 declare_juce_id(ipc_error);
 
 /// @brief ids for properties that aren't VST audio params, but are serialised.
-const std::array serialized_non_params{object_name, object_deleted};
+const std::array serialized_non_params{object_name, object_deleted,
+                                       world_oriented_encoding};
 
 } // namespace ambilink::ids